@@ -23,6 +23,12 @@ void ui_init_style(lv_style_t * style)
 		lv_style_init(style);
 }
 
+void ui_add_const_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selector_t selector)
+{
+	//LVGL never writes a style made by LV_STYLE_CONST_INIT, so it can stay in ROM
+	lv_obj_add_style(obj, (lv_style_t *)style, selector);
+}
+
 void ui_load_scr_animation(lv_ui *ui, lv_obj_t ** new_scr, bool new_scr_del, bool * old_scr_del, ui_setup_scr_t setup_scr,
                            lv_scr_load_anim_t anim_type, uint32_t time, uint32_t delay, bool is_clean, bool auto_del)
 {
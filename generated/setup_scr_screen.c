@@ -15,6 +15,51 @@
 #include "custom.h"
 
 
+//Constant styles of the screen, identical ones are shared by the widgets.
+//Style for screen, Part: LV_PART_MAIN, State: LV_STATE_DEFAULT.
+static const lv_style_const_prop_t style_screen_main_main_default_props[] = {
+	LV_STYLE_CONST_BG_OPA(0),
+};
+static LV_STYLE_CONST_INIT(style_screen_main_main_default, style_screen_main_main_default_props);
+
+//Style for screen_label_1, Part: LV_PART_MAIN, State: LV_STATE_DEFAULT.
+static const lv_style_const_prop_t style_screen_label_1_main_main_default_props[] = {
+	LV_STYLE_CONST_BORDER_WIDTH(0),
+	LV_STYLE_CONST_RADIUS(0),
+	LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+	LV_STYLE_CONST_TEXT_FONT(&lv_font_montserratMedium_29),
+	LV_STYLE_CONST_TEXT_OPA(255),
+	LV_STYLE_CONST_TEXT_LETTER_SPACE(2),
+	LV_STYLE_CONST_TEXT_LINE_SPACE(0),
+	LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+	LV_STYLE_CONST_BG_OPA(0),
+	LV_STYLE_CONST_PAD_TOP(0),
+	LV_STYLE_CONST_PAD_RIGHT(0),
+	LV_STYLE_CONST_PAD_BOTTOM(0),
+	LV_STYLE_CONST_PAD_LEFT(0),
+	LV_STYLE_CONST_SHADOW_WIDTH(0),
+};
+static LV_STYLE_CONST_INIT(style_screen_label_1_main_main_default, style_screen_label_1_main_main_default_props);
+
+//Style for screen_slider_1, Part: LV_PART_MAIN, State: LV_STATE_DEFAULT.
+static const lv_style_const_prop_t style_screen_slider_1_main_main_default_props[] = {
+	LV_STYLE_CONST_BG_OPA(60),
+	LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x21, 0x95, 0xf6)),
+	LV_STYLE_CONST_BG_GRAD_DIR(LV_GRAD_DIR_NONE),
+	LV_STYLE_CONST_RADIUS(50),
+	LV_STYLE_CONST_OUTLINE_WIDTH(0),
+	LV_STYLE_CONST_SHADOW_WIDTH(0),
+};
+static LV_STYLE_CONST_INIT(style_screen_slider_1_main_main_default, style_screen_slider_1_main_main_default_props);
+
+//Style for screen_slider_1, Part: LV_PART_INDICATOR and LV_PART_KNOB, State: LV_STATE_DEFAULT.
+static const lv_style_const_prop_t style_screen_slider_1_main_indicator_default_props[] = {
+	LV_STYLE_CONST_BG_OPA(255),
+	LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x21, 0x95, 0xf6)),
+	LV_STYLE_CONST_BG_GRAD_DIR(LV_GRAD_DIR_NONE),
+	LV_STYLE_CONST_RADIUS(50),
+};
+static LV_STYLE_CONST_INIT(style_screen_slider_1_main_indicator_default, style_screen_slider_1_main_indicator_default_props);
 
 void setup_scr_screen(lv_ui *ui)
 {
@@ -24,7 +69,7 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_scrollbar_mode(ui->screen, LV_SCROLLBAR_MODE_OFF);
 
 	//Write style for screen, Part: LV_PART_MAIN, State: LV_STATE_DEFAULT.
-	lv_obj_set_style_bg_opa(ui->screen, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
+	ui_add_const_style(ui->screen, &style_screen_main_main_default, LV_PART_MAIN|LV_STATE_DEFAULT);
 
 	//Write codes screen_label_1
 	ui->screen_label_1 = lv_label_create(ui->screen);
@@ -34,20 +79,7 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_size(ui->screen_label_1, 247, 44);
 
 	//Write style for screen_label_1, Part: LV_PART_MAIN, State: LV_STATE_DEFAULT.
-	lv_obj_set_style_border_width(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_radius(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_text_color(ui->screen_label_1, lv_color_hex(0x000000), LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_text_font(ui->screen_label_1, &lv_font_montserratMedium_29, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_text_opa(ui->screen_label_1, 255, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_text_letter_space(ui->screen_label_1, 2, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_text_line_space(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_text_align(ui->screen_label_1, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_opa(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_pad_top(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_pad_right(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_pad_bottom(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_pad_left(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_shadow_width(ui->screen_label_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
+	ui_add_const_style(ui->screen_label_1, &style_screen_label_1_main_main_default, LV_PART_MAIN|LV_STATE_DEFAULT);
 
 	//Write codes screen_slider_1
 	ui->screen_slider_1 = lv_slider_create(ui->screen);
@@ -58,24 +90,13 @@ void setup_scr_screen(lv_ui *ui)
 	lv_obj_set_size(ui->screen_slider_1, 277, 15);
 
 	//Write style for screen_slider_1, Part: LV_PART_MAIN, State: LV_STATE_DEFAULT.
-	lv_obj_set_style_bg_opa(ui->screen_slider_1, 60, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_color(ui->screen_slider_1, lv_color_hex(0x2195f6), LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_grad_dir(ui->screen_slider_1, LV_GRAD_DIR_NONE, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_radius(ui->screen_slider_1, 50, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_outline_width(ui->screen_slider_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
-	lv_obj_set_style_shadow_width(ui->screen_slider_1, 0, LV_PART_MAIN|LV_STATE_DEFAULT);
+	ui_add_const_style(ui->screen_slider_1, &style_screen_slider_1_main_main_default, LV_PART_MAIN|LV_STATE_DEFAULT);
 
 	//Write style for screen_slider_1, Part: LV_PART_INDICATOR, State: LV_STATE_DEFAULT.
-	lv_obj_set_style_bg_opa(ui->screen_slider_1, 255, LV_PART_INDICATOR|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_color(ui->screen_slider_1, lv_color_hex(0x2195f6), LV_PART_INDICATOR|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_grad_dir(ui->screen_slider_1, LV_GRAD_DIR_NONE, LV_PART_INDICATOR|LV_STATE_DEFAULT);
-	lv_obj_set_style_radius(ui->screen_slider_1, 50, LV_PART_INDICATOR|LV_STATE_DEFAULT);
+	ui_add_const_style(ui->screen_slider_1, &style_screen_slider_1_main_indicator_default, LV_PART_INDICATOR|LV_STATE_DEFAULT);
 
 	//Write style for screen_slider_1, Part: LV_PART_KNOB, State: LV_STATE_DEFAULT.
-	lv_obj_set_style_bg_opa(ui->screen_slider_1, 255, LV_PART_KNOB|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_color(ui->screen_slider_1, lv_color_hex(0x2195f6), LV_PART_KNOB|LV_STATE_DEFAULT);
-	lv_obj_set_style_bg_grad_dir(ui->screen_slider_1, LV_GRAD_DIR_NONE, LV_PART_KNOB|LV_STATE_DEFAULT);
-	lv_obj_set_style_radius(ui->screen_slider_1, 50, LV_PART_KNOB|LV_STATE_DEFAULT);
+	ui_add_const_style(ui->screen_slider_1, &style_screen_slider_1_main_indicator_default, LV_PART_KNOB|LV_STATE_DEFAULT);
 
 	//The custom code of screen.
 	
@@ -414,6 +414,117 @@ bool lv_obj_is_valid(const lv_obj_t * obj)
     return false;
 }
 
+void lv_obj_draw_main_on(lv_obj_t * obj, lv_event_t * e, const lv_area_t * coords)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    if(code == LV_EVENT_DRAW_MAIN) {
+        lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+        lv_draw_rect_dsc_t draw_dsc;
+        lv_draw_rect_dsc_init(&draw_dsc);
+        /*If the border is drawn later disable loading its properties*/
+        if(lv_obj_get_style_border_post(obj, LV_PART_MAIN)) {
+            draw_dsc.border_post = 1;
+        }
+
+        lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &draw_dsc);
+        lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
+        lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
+        lv_area_t draw_area;
+        lv_area_copy(&draw_area, coords);
+        draw_area.x1 -= w;
+        draw_area.x2 += w;
+        draw_area.y1 -= h;
+        draw_area.y2 += h;
+
+        lv_obj_draw_part_dsc_t part_dsc;
+        lv_obj_draw_dsc_init(&part_dsc, draw_ctx);
+        part_dsc.class_p = MY_CLASS;
+        part_dsc.type = LV_OBJ_DRAW_PART_RECTANGLE;
+        part_dsc.rect_dsc = &draw_dsc;
+        part_dsc.draw_area = &draw_area;
+        part_dsc.part = LV_PART_MAIN;
+        lv_event_send(obj, LV_EVENT_DRAW_PART_BEGIN, &part_dsc);
+
+#if LV_DRAW_COMPLEX
+        /*With clip corner enabled draw the bg img separately to make it clipped*/
+        bool clip_corner = (lv_obj_get_style_clip_corner(obj, LV_PART_MAIN) && draw_dsc.radius != 0) ? true : false;
+        const void * bg_img_src = draw_dsc.bg_img_src;
+        if(clip_corner) {
+            draw_dsc.bg_img_src = NULL;
+        }
+#endif
+
+        lv_draw_rect(draw_ctx, &draw_dsc, &draw_area);
+
+
+#if LV_DRAW_COMPLEX
+        if(clip_corner) {
+            lv_draw_mask_radius_param_t * mp = lv_mem_buf_get(sizeof(lv_draw_mask_radius_param_t));
+            lv_draw_mask_radius_init(mp, coords, draw_dsc.radius, false);
+            /*Add the mask and use `obj+8` as custom id. Don't use `obj` directly because it might be used by the user*/
+            lv_draw_mask_add(mp, obj + 8);
+
+            if(bg_img_src) {
+                draw_dsc.bg_opa = LV_OPA_TRANSP;
+                draw_dsc.border_opa = LV_OPA_TRANSP;
+                draw_dsc.outline_opa = LV_OPA_TRANSP;
+                draw_dsc.shadow_opa = LV_OPA_TRANSP;
+                draw_dsc.bg_img_src = bg_img_src;
+                lv_draw_rect(draw_ctx, &draw_dsc, &draw_area);
+            }
+
+        }
+#endif
+        lv_event_send(obj, LV_EVENT_DRAW_PART_END, &part_dsc);
+    }
+    else if(code == LV_EVENT_DRAW_POST) {
+        lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+        draw_scrollbar(obj, draw_ctx);
+
+#if LV_DRAW_COMPLEX
+        if(lv_obj_get_style_clip_corner(obj, LV_PART_MAIN)) {
+            lv_draw_mask_radius_param_t * param = lv_draw_mask_remove_custom(obj + 8);
+            if(param) {
+                lv_draw_mask_free_param(param);
+                lv_mem_buf_release(param);
+            }
+        }
+#endif
+
+        /*If the border is drawn later disable loading other properties*/
+        if(lv_obj_get_style_border_post(obj, LV_PART_MAIN)) {
+            lv_draw_rect_dsc_t draw_dsc;
+            lv_draw_rect_dsc_init(&draw_dsc);
+            draw_dsc.bg_opa = LV_OPA_TRANSP;
+            draw_dsc.bg_img_opa = LV_OPA_TRANSP;
+            draw_dsc.outline_opa = LV_OPA_TRANSP;
+            draw_dsc.shadow_opa = LV_OPA_TRANSP;
+            lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &draw_dsc);
+
+            lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
+            lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
+            lv_area_t draw_area;
+            lv_area_copy(&draw_area, coords);
+            draw_area.x1 -= w;
+            draw_area.x2 += w;
+            draw_area.y1 -= h;
+            draw_area.y2 += h;
+
+            lv_obj_draw_part_dsc_t part_dsc;
+            lv_obj_draw_dsc_init(&part_dsc, draw_ctx);
+            part_dsc.class_p = MY_CLASS;
+            part_dsc.type = LV_OBJ_DRAW_PART_BORDER_POST;
+            part_dsc.rect_dsc = &draw_dsc;
+            part_dsc.draw_area = &draw_area;
+            part_dsc.part = LV_PART_MAIN;
+            lv_event_send(obj, LV_EVENT_DRAW_PART_BEGIN, &part_dsc);
+
+            lv_draw_rect(draw_ctx, &draw_dsc, &draw_area);
+            lv_event_send(obj, LV_EVENT_DRAW_PART_END, &part_dsc);
+        }
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -480,6 +591,12 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
     }
+
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+    /*Last because removing from the group can still read the styles*/
+    lv_mem_free(obj->style_cache);
+    obj->style_cache = NULL;
+#endif
 }
 
 static void lv_obj_draw(lv_event_t * e)
@@ -523,111 +640,8 @@ static void lv_obj_draw(lv_event_t * e)
         info->res = LV_COVER_RES_COVER;
 
     }
-    else if(code == LV_EVENT_DRAW_MAIN) {
-        lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
-        lv_draw_rect_dsc_t draw_dsc;
-        lv_draw_rect_dsc_init(&draw_dsc);
-        /*If the border is drawn later disable loading its properties*/
-        if(lv_obj_get_style_border_post(obj, LV_PART_MAIN)) {
-            draw_dsc.border_post = 1;
-        }
-
-        lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &draw_dsc);
-        lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
-        lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
-        lv_area_t coords;
-        lv_area_copy(&coords, &obj->coords);
-        coords.x1 -= w;
-        coords.x2 += w;
-        coords.y1 -= h;
-        coords.y2 += h;
-
-        lv_obj_draw_part_dsc_t part_dsc;
-        lv_obj_draw_dsc_init(&part_dsc, draw_ctx);
-        part_dsc.class_p = MY_CLASS;
-        part_dsc.type = LV_OBJ_DRAW_PART_RECTANGLE;
-        part_dsc.rect_dsc = &draw_dsc;
-        part_dsc.draw_area = &coords;
-        part_dsc.part = LV_PART_MAIN;
-        lv_event_send(obj, LV_EVENT_DRAW_PART_BEGIN, &part_dsc);
-
-#if LV_DRAW_COMPLEX
-        /*With clip corner enabled draw the bg img separately to make it clipped*/
-        bool clip_corner = (lv_obj_get_style_clip_corner(obj, LV_PART_MAIN) && draw_dsc.radius != 0) ? true : false;
-        const void * bg_img_src = draw_dsc.bg_img_src;
-        if(clip_corner) {
-            draw_dsc.bg_img_src = NULL;
-        }
-#endif
-
-        lv_draw_rect(draw_ctx, &draw_dsc, &coords);
-
-
-#if LV_DRAW_COMPLEX
-        if(clip_corner) {
-            lv_draw_mask_radius_param_t * mp = lv_mem_buf_get(sizeof(lv_draw_mask_radius_param_t));
-            lv_draw_mask_radius_init(mp, &obj->coords, draw_dsc.radius, false);
-            /*Add the mask and use `obj+8` as custom id. Don't use `obj` directly because it might be used by the user*/
-            lv_draw_mask_add(mp, obj + 8);
-
-            if(bg_img_src) {
-                draw_dsc.bg_opa = LV_OPA_TRANSP;
-                draw_dsc.border_opa = LV_OPA_TRANSP;
-                draw_dsc.outline_opa = LV_OPA_TRANSP;
-                draw_dsc.shadow_opa = LV_OPA_TRANSP;
-                draw_dsc.bg_img_src = bg_img_src;
-                lv_draw_rect(draw_ctx, &draw_dsc, &coords);
-            }
-
-        }
-#endif
-        lv_event_send(obj, LV_EVENT_DRAW_PART_END, &part_dsc);
-    }
-    else if(code == LV_EVENT_DRAW_POST) {
-        lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
-        draw_scrollbar(obj, draw_ctx);
-
-#if LV_DRAW_COMPLEX
-        if(lv_obj_get_style_clip_corner(obj, LV_PART_MAIN)) {
-            lv_draw_mask_radius_param_t * param = lv_draw_mask_remove_custom(obj + 8);
-            if(param) {
-                lv_draw_mask_free_param(param);
-                lv_mem_buf_release(param);
-            }
-        }
-#endif
-
-        /*If the border is drawn later disable loading other properties*/
-        if(lv_obj_get_style_border_post(obj, LV_PART_MAIN)) {
-            lv_draw_rect_dsc_t draw_dsc;
-            lv_draw_rect_dsc_init(&draw_dsc);
-            draw_dsc.bg_opa = LV_OPA_TRANSP;
-            draw_dsc.bg_img_opa = LV_OPA_TRANSP;
-            draw_dsc.outline_opa = LV_OPA_TRANSP;
-            draw_dsc.shadow_opa = LV_OPA_TRANSP;
-            lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &draw_dsc);
-
-            lv_coord_t w = lv_obj_get_style_transform_width(obj, LV_PART_MAIN);
-            lv_coord_t h = lv_obj_get_style_transform_height(obj, LV_PART_MAIN);
-            lv_area_t coords;
-            lv_area_copy(&coords, &obj->coords);
-            coords.x1 -= w;
-            coords.x2 += w;
-            coords.y1 -= h;
-            coords.y2 += h;
-
-            lv_obj_draw_part_dsc_t part_dsc;
-            lv_obj_draw_dsc_init(&part_dsc, draw_ctx);
-            part_dsc.class_p = MY_CLASS;
-            part_dsc.type = LV_OBJ_DRAW_PART_BORDER_POST;
-            part_dsc.rect_dsc = &draw_dsc;
-            part_dsc.draw_area = &coords;
-            part_dsc.part = LV_PART_MAIN;
-            lv_event_send(obj, LV_EVENT_DRAW_PART_BEGIN, &part_dsc);
-
-            lv_draw_rect(draw_ctx, &draw_dsc, &coords);
-            lv_event_send(obj, LV_EVENT_DRAW_PART_END, &part_dsc);
-        }
+    else if(code == LV_EVENT_DRAW_MAIN || code == LV_EVENT_DRAW_POST) {
+        lv_obj_draw_main_on(obj, e, &obj->coords);
     }
 }
 
@@ -892,6 +906,9 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
 
+    /*The cached values of the object are stored per state but the children might inherit the changed ones*/
+    if(lv_obj_get_child_cnt(obj) > 0) _lv_obj_style_cache_invalidate(obj, LV_STYLE_PROP_ANY);
+
     _lv_obj_style_transition_dsc_t * ts = lv_mem_buf_get(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     lv_memset_00(ts, sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_disp.h"
+#include "lv_refr.h"
 #include "../misc/lv_gc.h"
 
 /*********************
@@ -15,6 +16,28 @@
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+#if (LV_OBJ_STYLE_CACHE_SIZE & (LV_OBJ_STYLE_CACHE_SIZE - 1)) != 0
+    #error "LV_OBJ_STYLE_CACHE_SIZE must be a power of 2"
+#endif
+
+/*The threads of the parallel rendering read the caches without locking, see `cache_read()`.
+ *It needs the atomic builtins of GCC/Clang. With other compilers the cache is not used while rendering in parallel.*/
+#if LV_USE_PARALLEL_REFR && defined(__GNUC__)
+    #define CACHE_ATOMIC                1
+    #define CACHE_LOAD(p)               __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define CACHE_LOAD_VALUE(p, v)      __atomic_load(p, v, __ATOMIC_ACQUIRE)
+    #define CACHE_STORE(p, x)           __atomic_store_n(p, x, __ATOMIC_RELEASE)
+    #define CACHE_STORE_VALUE(p, v)     __atomic_store(p, v, __ATOMIC_RELEASE)
+#else
+    #define CACHE_ATOMIC                0
+    #define CACHE_LOAD(p)               (*(p))
+    #define CACHE_LOAD_VALUE(p, v)      (*(v) = *(p))
+    #define CACHE_STORE(p, x)           (*(p) = (x))
+    #define CACHE_STORE_VALUE(p, v)     (*(p) = *(v))
+#endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -44,7 +67,15 @@ typedef enum {
  **********************/
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+static _lv_obj_style_cache_entry_t * get_cache_entry(lv_obj_t * obj, uint8_t part_key, lv_style_prop_t prop);
+static bool cache_read(const _lv_obj_style_cache_entry_t * entry, lv_style_prop_t prop, uint8_t part_key,
+                       lv_state_t state, lv_style_value_t * value);
+static void cache_write(_lv_obj_style_cache_entry_t * entry, lv_style_prop_t prop, uint8_t part_key,
+                        lv_state_t state, lv_style_value_t value);
+#endif
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
 static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
@@ -59,6 +90,9 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+static uint32_t style_cache_epoch = 1;
+#endif
 
 /**********************
  *      MACROS
@@ -152,6 +186,9 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    /*Any object can use the style, the cache has to be dropped even if the refresh is disabled*/
+    _lv_obj_style_cache_invalidate(NULL, LV_STYLE_PROP_ANY);
+
     if(!style_refr) return;
     lv_disp_t * d = lv_disp_get_next(NULL);
 
@@ -168,6 +205,8 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_style_cache_invalidate(obj, prop);
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -215,6 +254,22 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     }
 }
 
+void _lv_obj_style_cache_invalidate(lv_obj_t * obj, lv_style_prop_t prop)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+    if(obj == NULL || prop == LV_STYLE_PROP_ANY || lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT)) {
+        /*The caches check the epoch on the next read*/
+        style_cache_epoch++;
+    }
+    else if(obj->style_cache) {
+        lv_memset_00(obj->style_cache->entries, sizeof(obj->style_cache->entries));
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(prop);
+#endif
+}
+
 void lv_obj_enable_style_refresh(bool en)
 {
     style_refr = en;
@@ -222,49 +277,23 @@ void lv_obj_enable_style_refresh(bool en)
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
-    lv_style_value_t value_act;
-    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
-    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
-    while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
-        if(found == LV_STYLE_RES_FOUND) break;
-        if(!inheritable) break;
-
-        /*If not found, check the `MAIN` style first*/
-        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
-            part = LV_PART_MAIN;
-            continue;
-        }
-
-        /*Check the parent too.*/
-        obj = lv_obj_get_parent(obj);
-    }
-
-    if(found != LV_STYLE_RES_FOUND) {
-        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
-            const lv_obj_class_t * cls = obj->class_p;
-            while(cls) {
-                if(prop == LV_STYLE_WIDTH) {
-                    if(cls->width_def != 0) break;
-                }
-                else {
-                    if(cls->height_def != 0) break;
-                }
-                cls = cls->base_class;
-            }
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+#if LV_USE_PARALLEL_REFR && !CACHE_ATOMIC
+    if(_lv_refr_is_parallel()) return get_prop_resolved(obj, part, prop);
+#endif
 
-            if(cls) {
-                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
-            }
-            else {
-                value_act.num = 0;
-            }
-        }
-        else {
-            value_act = lv_style_prop_get_default(prop);
-        }
-    }
-    return value_act;
+    uint8_t part_key = (part >> 16) | (obj->skip_trans << 7);
+    lv_style_value_t value;
+    /*Reading the cache doesn't change the styles of the object*/
+    _lv_obj_style_cache_entry_t * entry = get_cache_entry((lv_obj_t *)obj, part_key, prop);
+    if(entry && cache_read(entry, prop, part_key, obj->state, &value)) return value;
+
+    value = get_prop_resolved(obj, part, prop);
+    if(entry) cache_write(entry, prop, part_key, obj->state, value);
+    return value;
+#else
+    return get_prop_resolved(obj, part, prop);
+#endif
 }
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
@@ -342,6 +371,7 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_cache_invalidate(obj, tr_dsc->prop);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -603,6 +633,60 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
 }
 
 
+/**
+ * Look up the value of a property in the styles of an object and its parents
+ * @param obj   pointer to an object
+ * @param part  a part of the object
+ * @param prop  a property
+ * @return      the value of the property or its default value
+ */
+static lv_style_value_t get_prop_resolved(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    lv_style_value_t value_act;
+    bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
+    lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
+    while(obj) {
+        found = get_prop_core(obj, part, prop, &value_act);
+        if(found == LV_STYLE_RES_FOUND) break;
+        if(!inheritable) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(found != LV_STYLE_RES_INHERIT && part != LV_PART_MAIN) {
+            part = LV_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        obj = lv_obj_get_parent(obj);
+    }
+
+    if(found != LV_STYLE_RES_FOUND) {
+        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
+            const lv_obj_class_t * cls = obj->class_p;
+            while(cls) {
+                if(prop == LV_STYLE_WIDTH) {
+                    if(cls->width_def != 0) break;
+                }
+                else {
+                    if(cls->height_def != 0) break;
+                }
+                cls = cls->base_class;
+            }
+
+            if(cls) {
+                value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
+            }
+            else {
+                value_act.num = 0;
+            }
+        }
+        else {
+            value_act = lv_style_prop_get_default(prop);
+        }
+    }
+    return value_act;
+}
+
 static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
 {
     uint8_t group = 1 << _lv_style_get_prop_group(prop);
@@ -670,6 +754,92 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_sty
     else return LV_STYLE_RES_NOT_FOUND;
 }
 
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+/**
+ * Get the cache entry of a property. Allocate the cache or drop the outdated values if required.
+ * @param obj       pointer to an object
+ * @param part_key  the part and the `skip_trans` flag as stored in the entries
+ * @param prop      a property
+ * @return          the entry of the property, it might store an other property. NULL if out of memory.
+ */
+static _lv_obj_style_cache_entry_t * get_cache_entry(lv_obj_t * obj, uint8_t part_key, lv_style_prop_t prop)
+{
+    _lv_obj_style_cache_t * cache = CACHE_LOAD(&obj->style_cache);
+    if(cache == NULL || CACHE_LOAD(&cache->epoch) != style_cache_epoch) {
+        /*Only one thread of the parallel rendering allocates or drops the entries.
+         *The others can't read them meanwhile as they see no cache or an old epoch too.*/
+        _lv_refr_parallel_lock();
+        cache = obj->style_cache;
+        if(cache == NULL) {
+            cache = lv_mem_alloc(sizeof(_lv_obj_style_cache_t));
+            if(cache) {
+                lv_memset_00(cache->entries, sizeof(cache->entries));
+                cache->epoch = style_cache_epoch;
+                CACHE_STORE(&obj->style_cache, cache);
+            }
+        }
+        else if(cache->epoch != style_cache_epoch) {
+            lv_memset_00(cache->entries, sizeof(cache->entries));
+            CACHE_STORE(&cache->epoch, style_cache_epoch);
+        }
+        _lv_refr_parallel_unlock();
+        if(cache == NULL) return NULL;
+    }
+
+    uint32_t i = (prop + part_key * 17 + obj->state) & (LV_OBJ_STYLE_CACHE_SIZE - 1);
+    return &cache->entries[i];
+}
+
+/**
+ * Read the value of a property from a cache entry.
+ * An other thread of the parallel rendering might write the entry meanwhile, so it's used only if
+ * its sequence number is even (not being written) and the same before and after reading it.
+ * The acquire loads keep the fields read between the two reads of the number.
+ * @param entry     pointer to an entry
+ * @param prop      the property to read
+ * @param part_key  the part and `skip_trans` as in the entry
+ * @param state     the current state of the object
+ * @param value     store the value here
+ * @return          true: the entry holds the value; false: it holds an other property or is being written
+ */
+static bool cache_read(const _lv_obj_style_cache_entry_t * entry, lv_style_prop_t prop, uint8_t part_key,
+                       lv_state_t state, lv_style_value_t * value)
+{
+    uint16_t seq = CACHE_LOAD(&entry->seq);
+    if(seq & 1) return false;
+
+    bool hit = CACHE_LOAD(&entry->prop) == prop && CACHE_LOAD(&entry->part) == part_key &&
+               CACHE_LOAD(&entry->state) == state;
+    CACHE_LOAD_VALUE(&entry->value, value);
+    return hit && CACHE_LOAD(&entry->seq) == seq;
+}
+
+/**
+ * Store the value of a property in a cache entry. See `cache_read()`.
+ * @param entry     pointer to an entry
+ * @param prop      the property
+ * @param part_key  the part and `skip_trans` of the object
+ * @param state     the current state of the object
+ * @param value     the resolved value of the property
+ */
+static void cache_write(_lv_obj_style_cache_entry_t * entry, lv_style_prop_t prop, uint8_t part_key,
+                        lv_state_t state, lv_style_value_t value)
+{
+    /*Only one thread writes the caches at once*/
+    _lv_refr_parallel_lock();
+    uint16_t seq = entry->seq;
+    /*The release stores keep the odd number visible before the new fields*/
+    CACHE_STORE(&entry->seq, (uint16_t)(seq + 1));
+    CACHE_STORE_VALUE(&entry->value, &value);
+    CACHE_STORE(&entry->prop, prop);
+    CACHE_STORE(&entry->part, part_key);
+    CACHE_STORE(&entry->state, state);
+
+    CACHE_STORE(&entry->seq, (uint16_t)(seq + 2));
+    _lv_refr_parallel_unlock();
+}
+#endif
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -740,6 +910,7 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
                     lv_style_remove_prop(obj->styles[i].style, tr->prop);
                 }
             }
+            _lv_obj_style_cache_invalidate(obj, tr->prop);
 
             /*Free the transition descriptor too*/
             lv_anim_del(tr, NULL);
@@ -835,6 +1006,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_cache_invalidate(tr->obj, tr->prop);
 
 }
 
@@ -865,6 +1037,7 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+                _lv_obj_style_cache_invalidate(obj, prop);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
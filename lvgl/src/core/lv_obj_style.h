@@ -54,6 +54,21 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+typedef struct {
+    lv_style_value_t value;     /**< The value returned by `lv_obj_get_style_prop()`*/
+    lv_style_prop_t prop;       /**< `LV_STYLE_PROP_INV` if the entry is unused*/
+    lv_state_t state;           /**< State of the object when the value was resolved*/
+    uint8_t part;               /**< The part shifted to bit 0 and `skip_trans` of the object on bit 7*/
+    uint16_t seq;               /**< Odd while the entry is being written, incremented by every write*/
+} _lv_obj_style_cache_entry_t;
+
+typedef struct {
+    uint32_t epoch;             /**< The entries are dropped when it differs from the global epoch*/
+    _lv_obj_style_cache_entry_t entries[LV_OBJ_STYLE_CACHE_SIZE];
+} _lv_obj_style_cache_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -111,6 +126,15 @@ void lv_obj_report_style_change(lv_style_t * style);
  */
 void lv_obj_refresh_style(struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+/**
+ * Drop the cached values of the style properties affected by a change.
+ * Called by `lv_obj_refresh_style()` and when the state or the parent of an object changes.
+ * @param obj       pointer to an object, or NULL to drop the cached values of every object
+ * @param prop      the changed property. If it's inheritable or `LV_STYLE_PROP_ANY`
+ *                  the cached values of every object are dropped because the children might inherit it.
+ */
+void _lv_obj_style_cache_invalidate(struct _lv_obj_t * obj, lv_style_prop_t prop);
+
 /**
  * Enable or disable automatic style refreshing when a new style is added/removed to/from an object
  * or any other style change happens.
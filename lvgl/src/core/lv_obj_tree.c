@@ -172,6 +172,9 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     obj->parent = parent;
 
+    /*The inherited style properties come from the new parent*/
+    _lv_obj_style_cache_invalidate(obj, LV_STYLE_PROP_ANY);
+
     /*Notify the original parent because one of its children is lost*/
     lv_obj_readjust_scroll(old_parent, LV_ANIM_OFF);
     lv_obj_scrollbar_invalidate(old_parent);
@@ -15,7 +15,9 @@
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../extra/others/snapshot/lv_snapshot.h"
 
@@ -26,6 +28,10 @@
 /*********************
  *      DEFINES
  *********************/
+#define PARALLEL_MIN_BAND_H     16  /*Don't make bands smaller than this many rows*/
+#define OCCLUDED_MAX            32  /*Covered objects to remember on an area*/
+#define OCCLUSION_PIECE_MAX     16  /*Visible parts to track while cutting the occluders out of an object*/
+#define OCCLUDED_CLIP_MAX       4   /*Draw a covered object part by part if it has this many visible parts at most*/
 
 /**********************
  *      TYPEDEFS
@@ -48,15 +54,52 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+#if LV_USE_PARALLEL_REFR
+typedef struct {
+    uint8_t * ctx_buf;      /*A copy of the draw context for each job*/
+    size_t ctx_size;        /*Size of a draw context in `ctx_buf` (aligned)*/
+} parallel_refr_dsc_t;
+#endif
+
+#if LV_REFR_OCCLUDER_CNT > 0
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t clips[OCCLUDED_CLIP_MAX];     /*Draw the object and its children only here*/
+    uint32_t clip_cnt;                      /*0: fully covered, don't draw it at all*/
+} occluded_obj_t;
+
+typedef struct {
+    lv_area_t occluders[LV_REFR_OCCLUDER_CNT];  /*Opaque areas in reverse drawing order*/
+    uint32_t occluder_cnt;
+    occluded_obj_t objs[OCCLUDED_MAX];
+    uint32_t obj_cnt;
+} occlusion_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static void refr_split_overlaps(void);
+static uint32_t area_cut(lv_area_t res[], const lv_area_t * a, const lv_area_t * b);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void refr_area_content(lv_draw_ctx_t * draw_ctx);
+#if LV_USE_PARALLEL_REFR
+    static void refr_area_parallel(lv_draw_ctx_t * draw_ctx);
+    static void refr_parallel_job(uint32_t job_id, void * user_data);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
+#if LV_REFR_OCCLUDER_CNT > 0
+    static void occlusion_build(const lv_area_t * area);
+    static void occlusion_add_obj(lv_obj_t * obj, const lv_area_t * clip, bool can_occlude,
+                                  const occluded_obj_t * occluded_parent);
+    static const occluded_obj_t * occlusion_cut(lv_obj_t * obj, const lv_area_t * area);
+    static uint32_t occlusion_join_pieces(lv_area_t pieces[], uint32_t piece_cnt);
+    static const occluded_obj_t * occlusion_find(const lv_obj_t * obj);
+#endif
 static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
@@ -76,6 +119,15 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
 
+#if LV_USE_PARALLEL_REFR
+    static const lv_refr_parallel_t * parallel_refr;
+    static volatile bool parallel_running;
+#endif
+
+#if LV_REFR_OCCLUDER_CNT > 0
+    static occlusion_t occlusion;   /*Built for the area being rendered, read-only while rendering it*/
+#endif
+
 #if LV_USE_PERF_MONITOR
     static perf_monitor_t   perf_monitor;
 #endif
@@ -144,9 +196,11 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
     if(should_draw) {
         draw_ctx->clip_area = &clip_coords_for_obj;
 
+        LV_PROFILER_BEGIN_OBJ("draw_main", obj);
         lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
         lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
         lv_event_send(obj, LV_EVENT_DRAW_MAIN_END, draw_ctx);
+        LV_PROFILER_END_OBJ("draw_main", obj);
 #if LV_USE_REFR_DEBUG
         lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
         lv_draw_rect_dsc_t draw_dsc;
@@ -188,9 +242,11 @@ void lv_obj_redraw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
         draw_ctx->clip_area = &clip_coords_for_obj;
 
         /*If all the children are redrawn make 'post draw' draw*/
+        LV_PROFILER_BEGIN_OBJ("draw_post", obj);
         lv_event_send(obj, LV_EVENT_DRAW_POST_BEGIN, draw_ctx);
         lv_event_send(obj, LV_EVENT_DRAW_POST, draw_ctx);
         lv_event_send(obj, LV_EVENT_DRAW_POST_END, draw_ctx);
+        LV_PROFILER_END_OBJ("draw_post", obj);
     }
 
     draw_ctx->clip_area = clip_area_ori;
@@ -251,12 +307,24 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Save the area*/
     if(disp->inv_p < LV_INV_BUF_SIZE) {
         lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
     }
-    else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+    else {
+        /*If no place for the area join it into the area growing the least by it.
+         *It's much less than redrawing the whole screen if only small areas are invalidated*/
+        uint32_t best_i = 0;
+        uint32_t best_grow = UINT32_MAX;
+        lv_area_t joined_area;
+        for(i = 0; i < disp->inv_p; i++) {
+            _lv_area_join(&joined_area, &disp->inv_areas[i], &com_area);
+            uint32_t grow = lv_area_get_size(&joined_area) - lv_area_get_size(&disp->inv_areas[i]);
+            if(grow < best_grow) {
+                best_grow = grow;
+                best_i = i;
+            }
+        }
+        _lv_area_join(&disp->inv_areas[best_i], &disp->inv_areas[best_i], &com_area);
     }
-    disp->inv_p++;
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
@@ -280,6 +348,28 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp)
     disp_refr = disp;
 }
 
+#if LV_USE_PARALLEL_REFR
+void lv_refr_set_parallel(const lv_refr_parallel_t * parallel)
+{
+    parallel_refr = parallel;
+}
+
+bool _lv_refr_is_parallel(void)
+{
+    return parallel_running;
+}
+
+void _lv_refr_parallel_lock(void)
+{
+    if(parallel_running && parallel_refr->lock_cb) parallel_refr->lock_cb();
+}
+
+void _lv_refr_parallel_unlock(void)
+{
+    if(parallel_running && parallel_refr->unlock_cb) parallel_refr->unlock_cb();
+}
+#endif
+
 /**
  * Called periodically to handle the refreshing
  * @param tmr pointer to the timer itself
@@ -305,6 +395,8 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         disp_refr = lv_disp_get_default();
     }
 
+    LV_PROFILER_BEGIN_TAG("refr");
+
     /*Refresh the screen's layout if required*/
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
@@ -316,6 +408,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
         LV_LOG_WARN("there is no active screen");
+        LV_PROFILER_END_TAG("refr");
         REFR_TRACE("finished");
         return;
     }
@@ -448,6 +541,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     }
 #endif
 
+    LV_PROFILER_END_TAG("refr");
     REFR_TRACE("finished");
 }
 
@@ -473,42 +567,141 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas which are cheaper to draw together than one by one.
+ * Drawing an area costs its pixels plus `LV_INV_AREA_OVERHEAD`, the overlapping parts are drawn only once
+ * as they are cut out by `refr_split_overlaps()`.
  */
 static void lv_refr_join_area(void)
 {
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    lv_area_t com_area;
+    lv_area_t pieces[4];
+    bool joined;
+
+    /*A joined area might be worth joining with the areas checked before, so repeat until nothing changes*/
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas and ignore itself*/
+                if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+                    continue;
+                }
 
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
+                lv_area_t * area_in = &disp_refr->inv_areas[join_in];
+                lv_area_t * area_from = &disp_refr->inv_areas[join_from];
+
+                /*The cost of drawing 'join_from' in addition to 'join_in'*/
+                uint32_t sep_size;
+                if(_lv_area_intersect(&com_area, area_in, area_from)) {
+                    uint32_t piece_cnt = area_cut(pieces, area_from, area_in);
+                    sep_size = lv_area_get_size(area_in) + lv_area_get_size(area_from) - lv_area_get_size(&com_area) +
+                               piece_cnt * LV_INV_AREA_OVERHEAD;
+                }
+                else {
+                    sep_size = lv_area_get_size(area_in) + lv_area_get_size(area_from) + LV_INV_AREA_OVERHEAD;
+                }
+
+                _lv_area_join(&joined_area, area_in, area_from);
+
+                /*Join two area only if the joined area is not more expensive*/
+                if(lv_area_get_size(&joined_area) <= sep_size) {
+                    lv_area_copy(area_in, &joined_area);
+
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
             }
+        }
+    } while(joined);
+
+    refr_split_overlaps();
+}
+
+/**
+ * Cut the overlapping parts out of the areas not worth joining to draw every pixel only once.
+ * The pieces are stored in the slots of the joined areas and after the last area.
+ * If there are not enough slots the two areas are joined instead.
+ */
+static void refr_split_overlaps(void)
+{
+    lv_area_t pieces[4];
+    uint32_t slots[4];
+    uint32_t i;
+    uint32_t j;
+
+    for(i = 0; i < disp_refr->inv_p; i++) {
+        if(disp_refr->inv_area_joined[i] != 0) continue;
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
+        for(j = 0; j < disp_refr->inv_p; j++) {
+            if(disp_refr->inv_area_joined[j] != 0 || i == j) continue;
+            if(_lv_area_is_on(&disp_refr->inv_areas[i], &disp_refr->inv_areas[j]) == false) continue;
+
+            uint32_t piece_cnt = area_cut(pieces, &disp_refr->inv_areas[j], &disp_refr->inv_areas[i]);
+            if(piece_cnt == 0) {
+                disp_refr->inv_area_joined[j] = 1;
                 continue;
             }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+            /*'j' is replaced by the first piece, find slots for the others.
+             *Only after 'i' to cut the overlaps with the pieces too.*/
+            uint32_t slot_cnt = 1;
+            uint32_t k;
+            slots[0] = j;
+            for(k = i + 1; k < disp_refr->inv_p && slot_cnt < piece_cnt; k++) {
+                if(disp_refr->inv_area_joined[k] != 0) slots[slot_cnt++] = k;
+            }
+            for(k = disp_refr->inv_p; k < LV_INV_BUF_SIZE && slot_cnt < piece_cnt; k++) {
+                slots[slot_cnt++] = k;
+            }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+            if(slot_cnt < piece_cnt) {
+                /*'i' grows so check all the areas again with it*/
+                _lv_area_join(&disp_refr->inv_areas[i], &disp_refr->inv_areas[i], &disp_refr->inv_areas[j]);
+                disp_refr->inv_area_joined[j] = 1;
+                i = (uint32_t) -1;
+                break;
+            }
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+            for(k = 0; k < piece_cnt; k++) {
+                disp_refr->inv_areas[slots[k]] = pieces[k];
+                disp_refr->inv_area_joined[slots[k]] = 0;
+                if(slots[k] >= disp_refr->inv_p) disp_refr->inv_p = slots[k] + 1;
             }
         }
     }
 }
 
+/**
+ * Get the parts of an area not covered by an other one
+ * @param res store the at most 4 parts here
+ * @param a the area to cut
+ * @param b the area to cut out of `a`. It has to be on `a`.
+ * @return number of the parts in `res` (0 if `b` covers `a`)
+ */
+static uint32_t area_cut(lv_area_t res[], const lv_area_t * a, const lv_area_t * b)
+{
+    lv_area_t com;
+    _lv_area_intersect(&com, a, b);
+
+    uint32_t cnt = 0;
+    /*Full width parts above and below the common part*/
+    if(a->y1 < com.y1) lv_area_set(&res[cnt++], a->x1, a->y1, a->x2, com.y1 - 1);
+    if(com.y2 < a->y2) lv_area_set(&res[cnt++], a->x1, com.y2 + 1, a->x2, a->y2);
+
+    /*Parts on the left and right of the common part*/
+    if(a->x1 < com.x1) lv_area_set(&res[cnt++], a->x1, com.y1, com.x1 - 1, com.y2);
+    if(com.x2 < a->x2) lv_area_set(&res[cnt++], com.x2 + 1, com.y1, a->x2, com.y2);
+
+    return cnt;
+}
+
 /**
  * Refresh the sync areas
  */
@@ -523,6 +716,12 @@ static void refr_sync_areas(void)
     /*Do not sync if no sync areas*/
     if(_lv_ll_is_empty(&disp_refr->sync_areas)) return;
 
+    /*The off screen buffer might be still shown if flushing is done asynchronously.
+     *Wait until the driver releases it*/
+    while(disp_refr->driver->draw_buf->flushing) {
+        if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+    }
+
     /*The buffers are already swapped.
      *So the active buffer is the off screen buffer where LVGL will render*/
     void * buf_off_screen = disp_refr->driver->draw_buf->buf_act;
@@ -590,6 +789,8 @@ static void refr_invalid_areas(void)
 
     if(disp_refr->inv_p == 0) return;
 
+    LV_PROFILER_BEGIN_TAG("refr_invalid_areas");
+
     /*Find the last area which will be drawn*/
     int32_t i;
     int32_t last_i = 0;
@@ -622,6 +823,8 @@ static void refr_invalid_areas(void)
     }
 
     disp_refr->rendering_in_progress = false;
+
+    LV_PROFILER_END_TAG("refr_invalid_areas");
 }
 
 /**
@@ -708,9 +911,11 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if((draw_buf->buf1 && !draw_buf->buf2) ||
        (draw_buf->buf1 && draw_buf->buf2 && full_sized)) {
+        LV_PROFILER_BEGIN_TAG("flush_wait");
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+        LV_PROFILER_END_TAG("flush_wait");
 
         /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
@@ -725,6 +930,31 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 #endif
     }
 
+#if LV_REFR_OCCLUDER_CNT > 0
+    occlusion_build(draw_ctx->clip_area);
+#endif
+
+#if LV_USE_PARALLEL_REFR
+    if(parallel_refr && parallel_refr->run_cb && parallel_refr->job_cnt > 1) refr_area_parallel(draw_ctx);
+    else refr_area_content(draw_ctx);
+#else
+    refr_area_content(draw_ctx);
+#endif
+
+#if LV_REFR_OCCLUDER_CNT > 0
+    /*Not to affect `lv_obj_redraw()` out of the refreshing, e.g. for snapshots*/
+    occlusion.obj_cnt = 0;
+#endif
+
+    draw_buf_flush(disp_refr);
+}
+
+/**
+ * Draw the screens and the layers of `disp_refr` on the clip area of a draw context
+ * @param draw_ctx  pointer to a draw context
+ */
+static void refr_area_content(lv_draw_ctx_t * draw_ctx)
+{
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -794,10 +1024,63 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
+}
 
-    draw_buf_flush(disp_refr);
+#if LV_USE_PARALLEL_REFR
+/**
+ * Split the clip area of a draw context to horizontal bands and render them with the jobs of `parallel_refr`.
+ * The bands don't overlap so the jobs draw to separate parts of the draw buffer.
+ * @param draw_ctx  pointer to a draw context
+ */
+static void refr_area_parallel(lv_draw_ctx_t * draw_ctx)
+{
+    const lv_area_t * clip_area = draw_ctx->clip_area;
+    lv_coord_t h = lv_area_get_height(clip_area);
+    uint32_t job_cnt = LV_MIN(parallel_refr->job_cnt, (uint32_t)(h / PARALLEL_MIN_BAND_H));
+    if(job_cnt < 2) {
+        refr_area_content(draw_ctx);
+        return;
+    }
+
+    parallel_refr_dsc_t dsc;
+    dsc.ctx_size = (disp_refr->driver->draw_ctx_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    dsc.ctx_buf = lv_mem_alloc(job_cnt * (dsc.ctx_size + sizeof(lv_area_t)));
+    LV_ASSERT_MALLOC(dsc.ctx_buf);
+    if(dsc.ctx_buf == NULL) {
+        refr_area_content(draw_ctx);
+        return;
+    }
+
+    lv_area_t * bands = (lv_area_t *)(dsc.ctx_buf + job_cnt * dsc.ctx_size);
+    uint32_t i;
+    for(i = 0; i < job_cnt; i++) {
+        bands[i].x1 = clip_area->x1;
+        bands[i].x2 = clip_area->x2;
+        bands[i].y1 = clip_area->y1 + (lv_coord_t)((h * i) / job_cnt);
+        bands[i].y2 = clip_area->y1 + (lv_coord_t)((h * (i + 1)) / job_cnt) - 1;
+
+        lv_draw_ctx_t * job_ctx = (lv_draw_ctx_t *)(dsc.ctx_buf + i * dsc.ctx_size);
+        lv_memcpy(job_ctx, draw_ctx, disp_refr->driver->draw_ctx_size);
+        job_ctx->clip_area = &bands[i];
+    }
+
+    parallel_running = true;
+    parallel_refr->run_cb(refr_parallel_job, &dsc, job_cnt);
+    parallel_running = false;
+
+    lv_mem_free(dsc.ctx_buf);
 }
 
+static void refr_parallel_job(uint32_t job_id, void * user_data)
+{
+    parallel_refr_dsc_t * dsc = user_data;
+    lv_draw_ctx_t * job_ctx = (lv_draw_ctx_t *)(dsc->ctx_buf + job_id * dsc->ctx_size);
+
+    refr_area_content(job_ctx);
+    lv_draw_wait_for_finish(job_ctx);
+}
+#endif
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -839,6 +1122,269 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     return found_p;
 }
 
+#if LV_REFR_OCCLUDER_CNT > 0
+/**
+ * Find the objects covered by opaque objects above them on an area.
+ * `lv_refr_get_top_obj()` finds only one object covering the whole area,
+ * this way the objects behind opaque siblings, cards, etc. are skipped or clipped too.
+ * @param area  the area to render
+ */
+static void occlusion_build(const lv_area_t * area)
+{
+    occlusion.occluder_cnt = 0;
+    occlusion.obj_cnt = 0;
+
+    /*Visit the objects in reverse drawing order (see `refr_area_content()`)
+     *to know all the opaque areas above an object when it's reached*/
+    occlusion_add_obj(lv_disp_get_layer_sys(disp_refr), area, true, NULL);
+    occlusion_add_obj(lv_disp_get_layer_top(disp_refr), area, true, NULL);
+
+    lv_obj_t * act_scr = lv_disp_get_scr_act(disp_refr);
+    if(disp_refr->draw_prev_over_act) {
+        occlusion_add_obj(disp_refr->prev_scr, area, true, NULL);
+        occlusion_add_obj(act_scr, area, true, NULL);
+    }
+    else {
+        occlusion_add_obj(act_scr, area, true, NULL);
+        occlusion_add_obj(disp_refr->prev_scr, area, true, NULL);
+    }
+}
+
+/**
+ * Check an object and its children in reverse drawing order.
+ * Remember the object if it's covered by the occluders found so far, and add it as an occluder if it's opaque.
+ * @param obj           pointer to an object
+ * @param clip          the clip area of the object, i.e. the area clipped by its parents
+ * @param can_occlude   false if the parents have masks, so the object might not cover what it reports
+ * @param occluded_parent   the nearest covered parent or NULL. The object is drawn only on its visible parts.
+ */
+static void occlusion_add_obj(lv_obj_t * obj, const lv_area_t * clip, bool can_occlude,
+                              const occluded_obj_t * occluded_parent)
+{
+    if(obj == NULL) return;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    /*Layers are drawn with their children in other buffers, leave them as they are*/
+    if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_NONE) return;
+
+    bool overflow_visible = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+
+    /*The area where the object draws itself, the same as in `lv_obj_redraw()`*/
+    lv_area_t obj_clip;
+    lv_area_t obj_coords_ext;
+    lv_obj_get_coords(obj, &obj_coords_ext);
+    lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords_ext, ext_draw_size, ext_draw_size);
+    bool on_clip = _lv_area_intersect(&obj_clip, clip, &obj_coords_ext);
+    if(!on_clip && !overflow_visible) return;
+
+    /*Out of the visible parts of the parent it's covered by the same occluders as the parent,
+     *so it needn't be remembered. It's skipped by `lv_obj_redraw()` anyway.*/
+    if(occluded_parent && !overflow_visible) {
+        uint32_t i;
+        for(i = 0; i < occluded_parent->clip_cnt; i++) {
+            if(_lv_area_is_on(&obj_clip, &occluded_parent->clips[i])) break;
+        }
+        if(i == occluded_parent->clip_cnt) return;
+    }
+
+    /*Check if the object covers its visible part. With rounded corners try without the corners too.
+     *Check it out of the clip area too as its masks affect its children which can be on the clip.*/
+    lv_area_t cover_area;
+    bool cover_on_clip = _lv_area_intersect(&cover_area, clip, &obj->coords);
+    if(!cover_on_clip) cover_area = obj->coords;
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &cover_area;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+
+    lv_coord_t r = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    r = LV_MIN(r, lv_area_get_width(&obj->coords) / 2);
+    if(cover_on_clip && info.res == LV_COVER_RES_NOT_COVER && r > 0) {
+        lv_area_t inner = obj->coords;
+        inner.x1 += r;
+        inner.x2 -= r;
+        if(_lv_area_intersect(&cover_area, clip, &inner)) {
+            info.res = LV_COVER_RES_COVER;
+            lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+        }
+    }
+
+    /*Only the occluders found so far are above the object, its own children can't hide it as they are drawn with it.
+     *With visible overflow the children can be out of `obj_clip`, so don't touch it.*/
+    lv_area_t clip_children;
+    bool children_on_clip = true;
+    if(overflow_visible) {
+        clip_children = *clip;
+    }
+    else {
+        const occluded_obj_t * occluded = occlusion_cut(obj, &obj_clip);
+        /*The object and its children are fully covered, nothing to add*/
+        if(occluded && occluded->clip_cnt == 0) return;
+        if(occluded) occluded_parent = occluded;
+
+        children_on_clip = _lv_area_intersect(&clip_children, clip, &obj->coords);
+        if(children_on_clip && occluded) {
+            /*The children out of the visible parts are not drawn either*/
+            lv_area_t visible = occluded->clips[0];
+            uint32_t i;
+            for(i = 1; i < occluded->clip_cnt; i++) {
+                _lv_area_join(&visible, &visible, &occluded->clips[i]);
+            }
+            children_on_clip = _lv_area_intersect(&clip_children, &clip_children, &visible);
+        }
+    }
+
+    /*The children are above the object.
+     *If the object has masks (e.g. clip corner) or opacity they might not cover what they report,
+     *as the cover check doesn't consider the opacity of the parents.*/
+    if(children_on_clip) {
+        bool children_can_occlude = can_occlude && info.res != LV_COVER_RES_MASKED &&
+                                    lv_obj_get_style_opa(obj, LV_PART_MAIN) >= LV_OPA_MAX;
+        int32_t i;
+        int32_t child_cnt = lv_obj_get_child_cnt(obj);
+        for(i = child_cnt - 1; i >= 0; i--) {
+            occlusion_add_obj(obj->spec_attr->children[i], &clip_children, children_can_occlude, occluded_parent);
+        }
+    }
+
+    if(can_occlude && cover_on_clip && info.res == LV_COVER_RES_COVER &&
+       occlusion.occluder_cnt < LV_REFR_OCCLUDER_CNT) {
+        occlusion.occluders[occlusion.occluder_cnt] = cover_area;
+        occlusion.occluder_cnt++;
+    }
+}
+
+/**
+ * Cut the occluders found so far out of the area of an object and remember the object if it's hidden or can be clipped
+ * @param obj       pointer to an object
+ * @param area      the area where the object draws itself and its children
+ * @return          the remembered object or NULL if it's not covered or there is no space to remember it
+ */
+static const occluded_obj_t * occlusion_cut(lv_obj_t * obj, const lv_area_t * area)
+{
+    if(occlusion.obj_cnt >= OCCLUDED_MAX) return NULL;
+
+    lv_area_t pieces[OCCLUSION_PIECE_MAX];
+    lv_area_t res[4];
+    uint32_t piece_cnt = 1;
+    bool cut = false;
+    pieces[0] = *area;
+
+    uint32_t i;
+    for(i = 0; i < occlusion.occluder_cnt && piece_cnt > 0; i++) {
+        const lv_area_t * occluder = &occlusion.occluders[i];
+        bool cut_now = false;
+        uint32_t p = 0;
+        while(p < piece_cnt) {
+            if(_lv_area_is_on(&pieces[p], occluder) == false) {
+                p++;
+                continue;
+            }
+
+            uint32_t res_cnt = area_cut(res, &pieces[p], occluder);
+            /*Keep the piece as it is if there is no space for its parts. It's drawn a little more only.*/
+            if(piece_cnt - 1 + res_cnt > OCCLUSION_PIECE_MAX) {
+                p++;
+                continue;
+            }
+
+            cut_now = true;
+            if(res_cnt == 0) {
+                /*Fully covered, check the last piece in its place*/
+                piece_cnt--;
+                pieces[p] = pieces[piece_cnt];
+                continue;
+            }
+
+            pieces[p] = res[0];
+            uint32_t r;
+            for(r = 1; r < res_cnt; r++) {
+                pieces[piece_cnt] = res[r];
+                piece_cnt++;
+            }
+            p++;
+        }
+
+        if(cut_now) {
+            piece_cnt = occlusion_join_pieces(pieces, piece_cnt);
+            cut = true;
+        }
+    }
+
+    if(!cut) return NULL;
+
+    occluded_obj_t * occluded = &occlusion.objs[occlusion.obj_cnt];
+    if(piece_cnt <= OCCLUDED_CLIP_MAX) {
+        /*Draw only the visible parts, e.g. the strip of a card below an other one*/
+        lv_memcpy_small(occluded->clips, pieces, piece_cnt * sizeof(lv_area_t));
+        occluded->clip_cnt = piece_cnt;
+    }
+    else {
+        /*Draw on the bounding box of the visible parts*/
+        occluded->clips[0] = pieces[0];
+        for(i = 1; i < piece_cnt; i++) {
+            _lv_area_join(&occluded->clips[0], &occluded->clips[0], &pieces[i]);
+        }
+        if(_lv_area_is_equal(&occluded->clips[0], area)) return NULL;
+        occluded->clip_cnt = 1;
+    }
+
+    occluded->obj = obj;
+    occlusion.obj_cnt++;
+    return occluded;
+}
+
+/**
+ * Join the visible parts of an object which are neighbors with the same width or height,
+ * e.g. the parts of a strip cut by a staircase of occluders
+ * @param pieces    array of not overlapping areas
+ * @param piece_cnt number of the areas
+ * @return          the new number of the areas
+ */
+static uint32_t occlusion_join_pieces(lv_area_t pieces[], uint32_t piece_cnt)
+{
+    uint32_t i = 0;
+    while(i < piece_cnt) {
+        lv_area_t * a = &pieces[i];
+        uint32_t j;
+        for(j = i + 1; j < piece_cnt; j++) {
+            const lv_area_t * b = &pieces[j];
+            bool ver = a->x1 == b->x1 && a->x2 == b->x2 && (a->y2 + 1 == b->y1 || b->y2 + 1 == a->y1);
+            bool hor = a->y1 == b->y1 && a->y2 == b->y2 && (a->x2 + 1 == b->x1 || b->x2 + 1 == a->x1);
+            if(ver || hor) break;
+        }
+
+        if(j == piece_cnt) {
+            i++;
+            continue;
+        }
+
+        /*The grown area might be the neighbor of an earlier one, so check all of them again*/
+        _lv_area_join(a, a, &pieces[j]);
+        piece_cnt--;
+        pieces[j] = pieces[piece_cnt];
+        i = 0;
+    }
+
+    return piece_cnt;
+}
+
+/**
+ * Get how an object is covered on the area being rendered
+ * @param obj   pointer to an object
+ * @return      the visible parts of the object or NULL if it's not covered
+ */
+static const occluded_obj_t * occlusion_find(const lv_obj_t * obj)
+{
+    uint32_t i;
+    for(i = 0; i < occlusion.obj_cnt; i++) {
+        if(occlusion.objs[i].obj == obj) return &occlusion.objs[i];
+    }
+
+    return NULL;
+}
+#endif /*LV_REFR_OCCLUDER_CNT > 0*/
+
 /**
  * Make the refreshing from an object. Draw all its children and the youngers too.
  * @param top_p pointer to an objects. Start the drawing from it.
@@ -969,6 +1515,25 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+#if LV_REFR_OCCLUDER_CNT > 0
+    /*Skip or clip the objects covered by opaque objects above them. Such objects are not layers.*/
+    const occluded_obj_t * occluded = occlusion_find(obj);
+    if(occluded) {
+        const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+        uint32_t i;
+        for(i = 0; i < occluded->clip_cnt; i++) {
+            lv_area_t clip_occluded;
+            if(!_lv_area_intersect(&clip_occluded, clip_area_ori, &occluded->clips[i])) continue;
+
+            draw_ctx->clip_area = &clip_occluded;
+            lv_obj_redraw(draw_ctx, obj);
+        }
+        draw_ctx->clip_area = clip_area_ori;
+        return;
+    }
+#endif
+
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(draw_ctx, obj);
@@ -1093,17 +1658,8 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
 {
     lv_coord_t area_w = lv_area_get_width(area);
     lv_coord_t area_h = lv_area_get_height(area);
-    uint32_t total = area_w * area_h;
-    /*Swap the beginning and end values*/
-    lv_color_t tmp;
-    uint32_t i = total - 1, j = 0;
-    while(i > j) {
-        tmp = color_p[i];
-        color_p[i] = color_p[j];
-        color_p[j] = tmp;
-        i--;
-        j++;
-    }
+    lv_draw_sw_rotate(color_p, color_p, area_w, area_h, area_w, area_w, LV_DISP_ROT_180, sizeof(lv_color_t));
+
     lv_coord_t tmp_coord;
     tmp_coord = area->y2;
     area->y2 = drv->ver_res - area->y1 - 1;
@@ -1113,24 +1669,11 @@ static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_
     area->x1 = drv->hor_res - tmp_coord - 1;
 }
 
-static void LV_ATTRIBUTE_FAST_MEM draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
-                                                     lv_color_t * orig_color_p, lv_color_t * rot_buf)
+static void draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
+                               lv_color_t * orig_color_p, lv_color_t * rot_buf)
 {
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
-        }
-    }
+    lv_draw_sw_rotate(orig_color_p, rot_buf, area_w, area_h, area_w, area_h,
+                      invert_i ? LV_DISP_ROT_270 : LV_DISP_ROT_90, sizeof(lv_color_t));
 }
 
 /**
@@ -1275,15 +1818,17 @@ static void draw_buf_flush(lv_disp_t * disp)
 
     /*Flush the rendered content to the display*/
     lv_draw_ctx_t * draw_ctx = disp->driver->draw_ctx;
-    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+    lv_draw_wait_for_finish(draw_ctx);
 
     /* In partial double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer */
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if(draw_buf->buf1 && draw_buf->buf2 && !full_sized) {
+        LV_PROFILER_BEGIN_TAG("flush_wait");
         while(draw_buf->flushing) {
             if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
         }
+        LV_PROFILER_END_TAG("flush_wait");
     }
 
     draw_buf->flushing = 1;
@@ -1324,7 +1869,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+    LV_PROFILER_BEGIN_TAG("flush_cb");
     drv->flush_cb(drv, &offset_area, color_p);
+    LV_PROFILER_END_TAG("flush_cb");
 }
 
 #if LV_USE_PERF_MONITOR
@@ -26,6 +26,37 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_PARALLEL_REFR
+/**
+ * A job of the parallel rendering. `job_id` is in `[0, job_cnt)`.
+ */
+typedef void (*lv_refr_parallel_job_cb_t)(uint32_t job_id, void * user_data);
+
+/**
+ * Describes how to render the bands of the draw buffer in parallel.
+ * The callbacks are provided by the port, typically with a thread pool.
+ */
+typedef struct {
+    /**
+     * Call `job_cb(job_id, user_data)` for every `job_id` in `[0, job_cnt)` on any threads
+     * and return only when all the jobs are finished.
+     */
+    void (*run_cb)(lv_refr_parallel_job_cb_t job_cb, void * user_data, uint32_t job_cnt);
+
+    /**
+     * Lock/unlock a recursive mutex.
+     * Used to protect the shared resources (heap, image cache, etc.) while the jobs run.
+     */
+    void (*lock_cb)(void);
+    void (*unlock_cb)(void);
+
+    /**
+     * Max. number of bands to split an area to, typically the number of threads used by `run_cb`
+     */
+    uint32_t job_cnt;
+} lv_refr_parallel_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -85,6 +116,39 @@ lv_disp_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 
+#if LV_USE_PARALLEL_REFR
+/**
+ * Render the draw buffer in horizontal bands in parallel.
+ * Each band is rendered independently into its own part of the draw buffer.
+ * The widget tree is only read by the jobs and it's not modified while they run.
+ * @param parallel  pointer to an initialized descriptor, only its pointer is saved.
+ *                  NULL to render from the calling thread only.
+ */
+void lv_refr_set_parallel(const lv_refr_parallel_t * parallel);
+
+/**
+ * Tell if the bands are being rendered in parallel now.
+ * Caches which are not thread-safe shall be bypassed in this case.
+ * @return true: the bands are being rendered by the jobs of `lv_refr_parallel_t`
+ */
+bool _lv_refr_is_parallel(void);
+
+/**
+ * Lock the mutex of the parallel rendering if it's in progress.
+ * Used to protect the shared resources from the render jobs.
+ */
+void _lv_refr_parallel_lock(void);
+
+/**
+ * Unlock the mutex of the parallel rendering if it's in progress.
+ */
+void _lv_refr_parallel_unlock(void);
+#else
+#define _lv_refr_is_parallel()          false
+#define _lv_refr_parallel_lock()
+#define _lv_refr_parallel_unlock()
+#endif
+
 #if LV_USE_PERF_MONITOR
 /**
  * Reset FPS counter
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_draw.h"
 #include "sw/lv_draw_sw.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -44,7 +45,11 @@ void lv_draw_init(void)
 
 void lv_draw_wait_for_finish(lv_draw_ctx_t * draw_ctx)
 {
-    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+    if(draw_ctx->wait_for_finish == NULL) return;
+
+    LV_PROFILER_BEGIN_TAG("gpu_wait");
+    draw_ctx->wait_for_finish(draw_ctx);
+    LV_PROFILER_END_TAG("gpu_wait");
 }
 
 /**********************
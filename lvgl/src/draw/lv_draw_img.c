@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -70,6 +71,8 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+    LV_PROFILER_BEGIN_TAG("draw_img");
+
     lv_res_t res = LV_RES_INV;
 
     if(draw_ctx->draw_img) {
@@ -77,13 +80,18 @@ void lv_draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const
     }
 
     if(res != LV_RES_OK) {
+        /*The image cache and the decoders are shared by the threads of the parallel rendering*/
+        _lv_refr_parallel_lock();
         res = decode_and_draw(draw_ctx, dsc, coords, src);
+        _lv_refr_parallel_unlock();
     }
 
     if(res != LV_RES_OK) {
         LV_LOG_WARN("Image draw error");
         show_error(draw_ctx, coords, "No\ndata");
     }
+
+    LV_PROFILER_END_TAG("draw_img");
 }
 
 /**
@@ -13,6 +13,7 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -101,6 +102,8 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, draw_ctx->clip_area);
     if(!clip_ok) return;
 
+    LV_PROFILER_BEGIN_TAG("draw_label");
+
     lv_text_align_t align = dsc->align;
     lv_base_dir_t base_dir = dsc->bidi_dir;
 
@@ -167,7 +170,10 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             hint->coord_y    = coords->y1;
         }
 
-        if(txt[line_start] == '\0') return;
+        if(txt[line_start] == '\0') {
+            LV_PROFILER_END_TAG("draw_label");
+            return;
+        }
     }
 
     /*Align to middle*/
@@ -355,9 +361,11 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > draw_ctx->clip_area->y2) return;
+        if(pos.y > draw_ctx->clip_area->y2) break;
     }
 
+    LV_PROFILER_END_TAG("draw_label");
+
     LV_ASSERT_MEM_INTEGRITY();
 }
 
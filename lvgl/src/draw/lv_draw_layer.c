@@ -52,6 +52,7 @@ lv_draw_layer_ctx_t * lv_draw_layer_create(lv_draw_ctx_t * draw_ctx, const lv_ar
     layer_ctx->original.buf = draw_ctx->buf;
     layer_ctx->original.buf_area = draw_ctx->buf_area;
     layer_ctx->original.clip_area = draw_ctx->clip_area;
+    layer_ctx->original.buf_rot_270 = draw_ctx->buf_rot_270;
     layer_ctx->original.screen_transp = disp_refr->driver->screen_transp;
     layer_ctx->area_full = *layer_area;
 
@@ -81,6 +82,7 @@ void lv_draw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer
     draw_ctx->buf = layer_ctx->original.buf;
     draw_ctx->buf_area = layer_ctx->original.buf_area;
     draw_ctx->clip_area = layer_ctx->original.clip_area;
+    draw_ctx->buf_rot_270 = layer_ctx->original.buf_rot_270;
     lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
     disp_refr->driver->screen_transp = layer_ctx->original.screen_transp;
 
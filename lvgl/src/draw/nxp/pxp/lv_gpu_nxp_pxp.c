@@ -106,10 +106,17 @@ void lv_gpu_nxp_pxp_reset(void)
     /* Wait for previous command to complete before resetting the registers. */
     lv_gpu_nxp_pxp_wait();
 
+#if LV_USE_GPU_NXP_PXP_AUTO_INIT
+    /* Other tasks use the PXP between the jobs of LVGL. It's released when the job started after the reset completes. */
+    lv_gpu_nxp_pxp_lock();
+#endif
+
     PXP_ResetControl(LV_GPU_NXP_PXP_ID);
 
     PXP_EnableCsc1(LV_GPU_NXP_PXP_ID, false); /*Disable CSC1, it is enabled by default.*/
     PXP_SetProcessBlockSize(LV_GPU_NXP_PXP_ID, kPXP_BlockSize16); /*Block size 16x16 for higher performance*/
+    /*Enable the interrupt disabled by the reset, it releases the PXP after the jobs started without lv_gpu_nxp_pxp_run()*/
+    PXP_EnableInterrupts(LV_GPU_NXP_PXP_ID, kPXP_CompleteInterruptEnable);
 }
 
 void lv_gpu_nxp_pxp_run(void)
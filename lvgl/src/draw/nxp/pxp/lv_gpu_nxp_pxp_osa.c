@@ -80,9 +80,17 @@ static void _lv_gpu_nxp_pxp_wait(void);
 
 #if defined(SDK_OS_FREE_RTOS)
     static SemaphoreHandle_t s_pxpIdleSem;
+    /*Taken while a job is configured or running, given back in the interrupt when the job completes*/
+    static SemaphoreHandle_t s_pxpLockSem;
 #endif
 static volatile bool s_pxpIdle;
 
+/*Callback set for the next job and callback of the running job*/
+static lv_gpu_nxp_pxp_complete_cb_t s_pxpNextCompleteCb;
+static void * s_pxpNextCompleteData;
+static volatile lv_gpu_nxp_pxp_complete_cb_t s_pxpCompleteCb;
+static void * volatile s_pxpCompleteData;
+
 static lv_nxp_pxp_cfg_t pxp_default_cfg = {
     .pxp_interrupt_init = _lv_gpu_nxp_pxp_interrupt_init,
     .pxp_interrupt_deinit = _lv_gpu_nxp_pxp_interrupt_deinit,
@@ -106,8 +114,16 @@ void PXP_IRQHandler(void)
 
     if(kPXP_CompleteFlag & PXP_GetStatusFlags(LV_GPU_NXP_PXP_ID)) {
         PXP_ClearStatusFlags(LV_GPU_NXP_PXP_ID, kPXP_CompleteFlag);
+
+        lv_gpu_nxp_pxp_complete_cb_t complete_cb = s_pxpCompleteCb;
+        if(complete_cb != NULL) {
+            s_pxpCompleteCb = NULL;
+            complete_cb(s_pxpCompleteData);
+        }
+
 #if defined(SDK_OS_FREE_RTOS)
         xSemaphoreGiveFromISR(s_pxpIdleSem, &taskAwake);
+        xSemaphoreGiveFromISR(s_pxpLockSem, &taskAwake);
         portYIELD_FROM_ISR(taskAwake);
 #else
         s_pxpIdle = true;
@@ -120,6 +136,29 @@ lv_nxp_pxp_cfg_t * lv_gpu_nxp_pxp_get_cfg(void)
     return &pxp_default_cfg;
 }
 
+void lv_gpu_nxp_pxp_set_complete_cb(lv_gpu_nxp_pxp_complete_cb_t complete_cb, void * user_data)
+{
+    s_pxpNextCompleteCb = complete_cb;
+    s_pxpNextCompleteData = user_data;
+}
+
+void lv_gpu_nxp_pxp_lock(void)
+{
+#if defined(SDK_OS_FREE_RTOS)
+    xSemaphoreTake(s_pxpLockSem, portMAX_DELAY);
+#endif
+}
+
+void lv_gpu_nxp_pxp_run_async(lv_gpu_nxp_pxp_complete_cb_t complete_cb, void * user_data)
+{
+    /*The job of the caller, the callback set for the next job of LVGL is kept*/
+    s_pxpCompleteData = user_data;
+    s_pxpCompleteCb = complete_cb;
+
+    PXP_EnableInterrupts(LV_GPU_NXP_PXP_ID, kPXP_CompleteInterruptEnable);
+    PXP_Start(LV_GPU_NXP_PXP_ID);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -131,6 +170,13 @@ static lv_res_t _lv_gpu_nxp_pxp_interrupt_init(void)
     if(s_pxpIdleSem == NULL)
         return LV_RES_INV;
 
+    s_pxpLockSem = xSemaphoreCreateBinary();
+    if(s_pxpLockSem == NULL) {
+        vSemaphoreDelete(s_pxpIdleSem);
+        return LV_RES_INV;
+    }
+    xSemaphoreGive(s_pxpLockSem);
+
     NVIC_SetPriority(LV_GPU_NXP_PXP_IRQ_ID, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1);
 #endif
     s_pxpIdle = true;
@@ -145,6 +191,7 @@ static void _lv_gpu_nxp_pxp_interrupt_deinit(void)
     NVIC_DisableIRQ(LV_GPU_NXP_PXP_IRQ_ID);
 #if defined(SDK_OS_FREE_RTOS)
     vSemaphoreDelete(s_pxpIdleSem);
+    vSemaphoreDelete(s_pxpLockSem);
 #endif
 }
 
@@ -154,6 +201,14 @@ static void _lv_gpu_nxp_pxp_interrupt_deinit(void)
 static void _lv_gpu_nxp_pxp_run(void)
 {
     s_pxpIdle = false;
+#if defined(SDK_OS_FREE_RTOS)
+    /*Drop the completion of a job nobody waited for, e.g. of another task*/
+    xSemaphoreTake(s_pxpIdleSem, 0);
+#endif
+
+    s_pxpCompleteData = s_pxpNextCompleteData;
+    s_pxpCompleteCb = s_pxpNextCompleteCb;
+    s_pxpNextCompleteCb = NULL;
 
     PXP_EnableInterrupts(LV_GPU_NXP_PXP_ID, kPXP_CompleteInterruptEnable);
     PXP_Start(LV_GPU_NXP_PXP_ID);
@@ -38,6 +38,17 @@ typedef struct {
     lv_coord_t w, h, radius;
 } lv_draw_img_rounded_key_t;
 
+typedef struct {
+    lv_sdl_cache_key_magic_t magic;
+    const void * src;
+} lv_draw_img_yuv_key_t;
+
+typedef struct {
+    lv_draw_sdl_img_header_t header;
+    uint32_t frame_id;
+    bool uploaded;
+} lv_draw_sdl_yuv_userdata_t;
+
 enum {
     ROUNDED_IMG_PART_LEFT = 0,
     ROUNDED_IMG_PART_HCENTER = 1,
@@ -64,6 +75,9 @@ static SDL_Texture * upload_img_texture_fallback(SDL_Renderer * renderer, lv_img
 
 static bool check_mask_simple_radius(const lv_area_t * coords, lv_coord_t * radius);
 
+static void draw_img_texture(lv_draw_sdl_ctx_t * ctx, SDL_Texture * texture, const lv_draw_sdl_img_header_t * header,
+                             const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords);
+
 static void draw_img_simple(lv_draw_sdl_ctx_t * ctx, SDL_Texture * texture, const lv_draw_sdl_img_header_t * header,
                             const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords, const lv_area_t * clip);
 
@@ -98,7 +112,6 @@ static void apply_recolor_opa(SDL_Texture * texture, const lv_draw_img_dsc_t * d
 lv_res_t lv_draw_sdl_img_core(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
                               const lv_area_t * coords, const void * src)
 {
-    const lv_area_t * clip = draw_ctx->clip_area;
     lv_draw_sdl_ctx_t * ctx = (lv_draw_sdl_ctx_t *) draw_ctx;
 
     size_t key_size;
@@ -120,6 +133,77 @@ lv_res_t lv_draw_sdl_img_core(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t
         return LV_RES_INV;
     }
 
+    draw_img_texture(ctx, texture, header, draw_dsc, coords);
+
+    if(!texture_in_cache) {
+        LV_LOG_WARN("Texture is not cached, this will impact performance.");
+        if(!header->managed) {
+            SDL_DestroyTexture(texture);
+        }
+        lv_mem_free(header);
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_draw_sdl_img_yuv(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                             const lv_area_t * coords, const void * src, const uint8_t * data,
+                             lv_coord_t w, lv_coord_t h, uint32_t frame_id)
+{
+    lv_draw_sdl_ctx_t * ctx = (lv_draw_sdl_ctx_t *) draw_ctx;
+
+    lv_draw_img_yuv_key_t key;
+    /* Padding between members is uninitialized, so we have to wipe them manually */
+    SDL_memset(&key, 0, sizeof(key));
+    key.magic = LV_GPU_CACHE_KEY_MAGIC_IMG_YUV;
+    key.src = src;
+
+    lv_draw_sdl_yuv_userdata_t * userdata = NULL;
+    SDL_Texture * texture = lv_draw_sdl_texture_cache_get_with_userdata(ctx, &key, sizeof(key), NULL,
+                                                                        (void **) &userdata);
+    bool texture_in_cache = true;
+    if(!texture || !userdata || userdata->header.base.w != w || userdata->header.base.h != h) {
+        /* The renderer converts the colors and scales, the texture is updated with each frame */
+        texture = SDL_CreateTexture(ctx->renderer, SDL_PIXELFORMAT_IYUV, SDL_TEXTUREACCESS_STREAMING, w, h);
+        if(!texture) {
+            return LV_RES_INV;
+        }
+        userdata = SDL_malloc(sizeof(lv_draw_sdl_yuv_userdata_t));
+        SDL_memset(userdata, 0, sizeof(lv_draw_sdl_yuv_userdata_t));
+        userdata->header.base.cf = LV_IMG_CF_TRUE_COLOR;
+        userdata->header.base.w = w;
+        userdata->header.base.h = h;
+        /* Replaces the texture of the previous size */
+        texture_in_cache = lv_draw_sdl_texture_cache_put_advanced(ctx, &key, sizeof(key), texture, userdata, SDL_free,
+                                                                  0);
+    }
+
+    if(!userdata->uploaded || userdata->frame_id != frame_id) {
+        /* The U and V planes follow the Y plane with half pitch */
+        SDL_UpdateTexture(texture, NULL, data, w);
+        userdata->frame_id = frame_id;
+        userdata->uploaded = true;
+    }
+
+    draw_img_texture(ctx, texture, &userdata->header, draw_dsc, coords);
+
+    if(!texture_in_cache) {
+        LV_LOG_WARN("Texture is not cached, this will impact performance.");
+        SDL_DestroyTexture(texture);
+        SDL_free(userdata);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Draw a texture with the zoom, the radius mask and the composite of the image draw descriptor
+ */
+static void draw_img_texture(lv_draw_sdl_ctx_t * ctx, SDL_Texture * texture, const lv_draw_sdl_img_header_t * header,
+                             const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords)
+{
+    const lv_area_t * clip = ctx->base_draw.clip_area;
+
     lv_area_t zoomed_cords;
     _lv_img_buf_get_transformed_area(&zoomed_cords, lv_area_get_width(coords), lv_area_get_height(coords), 0,
                                      draw_dsc->zoom, &draw_dsc->pivot);
@@ -153,16 +237,6 @@ lv_res_t lv_draw_sdl_img_core(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t
     }
 
     lv_draw_sdl_composite_end(ctx, &apply_area, draw_dsc->blend_mode);
-
-    if(!texture_in_cache) {
-        LV_LOG_WARN("Texture is not cached, this will impact performance.");
-        if(!header->managed) {
-            SDL_DestroyTexture(texture);
-        }
-        lv_mem_free(header);
-    }
-
-    return LV_RES_OK;
 }
 
 static void calc_draw_part(SDL_Texture * texture, const lv_draw_sdl_img_header_t * header, const lv_area_t * coords,
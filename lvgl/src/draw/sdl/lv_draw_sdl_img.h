@@ -73,6 +73,23 @@ typedef struct lv_draw_sdl_img_header_t {
 bool lv_draw_sdl_img_load_texture(lv_draw_sdl_ctx_t * ctx, lv_draw_sdl_cache_key_head_img_t * key, size_t key_size,
                                   const void * src, int32_t frame_id, SDL_Texture ** texture,
                                   lv_draw_sdl_img_header_t ** header, bool * texture_in_cache);
+
+/**
+ * Draw a YUV 4:2:0 picture, e.g. a frame of a video. The renderer converts the colors and scales it to `coords`.
+ * It's uploaded into an `SDL_PIXELFORMAT_IYUV` streaming texture cached for `src`, only if `frame_id` changed.
+ * @param draw_ctx Drawing context
+ * @param draw_dsc Image draw descriptor, zoom, angle and opacity are applied
+ * @param coords Area of the picture
+ * @param src Identifies the texture in the cache, e.g. the object showing the picture
+ * @param data I420 planes without padding: `w * h` Y, then `((w + 1) / 2) * ((h + 1) / 2)` U and V
+ * @param w Width of the picture
+ * @param h Height of the picture
+ * @param frame_id Changes with the content of `data`
+ * @return LV_RES_OK: drawn; LV_RES_INV: the texture can't be created
+ */
+lv_res_t lv_draw_sdl_img_yuv(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
+                             const lv_area_t * coords, const void * src, const uint8_t * data,
+                             lv_coord_t w, lv_coord_t h, uint32_t frame_id);
 /**********************
  *      MACROS
  **********************/
@@ -46,6 +46,7 @@ typedef enum {
     LV_GPU_CACHE_KEY_MAGIC_ARC = 0x01,
     LV_GPU_CACHE_KEY_MAGIC_IMG = 0x11,
     LV_GPU_CACHE_KEY_MAGIC_IMG_ROUNDED_CORNERS = 0x12,
+    LV_GPU_CACHE_KEY_MAGIC_IMG_YUV = 0x13,
     LV_GPU_CACHE_KEY_MAGIC_LINE = 0x21,
     LV_GPU_CACHE_KEY_MAGIC_RECT_BG = 0x31,
     LV_GPU_CACHE_KEY_MAGIC_RECT_SHADOW = 0x32,
@@ -12,14 +12,41 @@
 /*********************
  *      DEFINES
  *********************/
+/*Edge of the square tiles used by the 90/270 degree rotation: two cache lines of pixels*/
+#define ROTATE_TILE_SIZE(px_size)   LV_MAX((LV_DRAW_SW_CACHE_LINE_SIZE * 2) / (px_size), 8)
+
+#if LV_DRAW_SW_ROTATE_VECTOR && defined(__GNUC__)
+    #define ROTATE_VECTOR 1
+#else
+    #define ROTATE_VECTOR 0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef void (*rotate_tile_cb_t)(const uint8_t * src, lv_coord_t src_stride, uint8_t * dest, lv_coord_t dest_step,
+                                 lv_coord_t w, lv_coord_t h, bool is_270);
+
+#if ROTATE_VECTOR
+typedef uint16_t rotate_v8u16_t __attribute__((vector_size(16)));
+typedef uint32_t rotate_v4u32_t __attribute__((vector_size(16)));
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void rotate_tile_8(const uint8_t * src, lv_coord_t src_stride, uint8_t * dest, lv_coord_t dest_step,
+                          lv_coord_t w, lv_coord_t h, bool is_270);
+static void rotate_tile_16(const uint8_t * src, lv_coord_t src_stride, uint8_t * dest, lv_coord_t dest_step,
+                           lv_coord_t w, lv_coord_t h, bool is_270);
+static void rotate_tile_32(const uint8_t * src, lv_coord_t src_stride, uint8_t * dest, lv_coord_t dest_step,
+                           lv_coord_t w, lv_coord_t h, bool is_270);
+static inline void rotate_tile_16_scalar(const uint16_t * src, lv_coord_t src_stride, uint16_t * dest,
+                                         lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270);
+static inline void rotate_tile_32_scalar(const uint32_t * src, lv_coord_t src_stride, uint32_t * dest,
+                                         lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270);
+static void rotate_180(const uint8_t * src, uint8_t * dest, lv_coord_t src_w, lv_coord_t src_h,
+                       lv_coord_t src_stride, lv_coord_t dest_stride, uint8_t px_size);
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -32,6 +59,13 @@
 /**********************
  *      MACROS
  **********************/
+#if ROTATE_VECTOR
+    #if defined(__clang__)
+        #define ROTATE_SHUFFLE(type, a, b, ...) __builtin_shufflevector(a, b, __VA_ARGS__)
+    #else
+        #define ROTATE_SHUFFLE(type, a, b, ...) __builtin_shuffle(a, b, (type){__VA_ARGS__})
+    #endif
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -103,6 +137,311 @@ void lv_draw_sw_buffer_copy(lv_draw_ctx_t * draw_ctx,
     }
 }
 
+void lv_draw_sw_rotate(const void * src, void * dest, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       lv_coord_t dest_stride, lv_disp_rot_t rotation, uint8_t px_size)
+{
+    const uint8_t * src8 = src;
+    uint8_t * dest8 = dest;
+
+    if(rotation == LV_DISP_ROT_NONE) {
+        lv_coord_t y;
+        for(y = 0; y < src_h; y++) {
+            lv_memcpy(dest8, src8, src_w * px_size);
+            src8 += src_stride * px_size;
+            dest8 += dest_stride * px_size;
+        }
+        return;
+    }
+
+    if(rotation == LV_DISP_ROT_180) {
+        rotate_180(src8, dest8, src_w, src_h, src_stride, dest_stride, px_size);
+        return;
+    }
+
+    rotate_tile_cb_t tile_cb;
+    switch(px_size) {
+        case 1:
+            tile_cb = rotate_tile_8;
+            break;
+        case 2:
+            tile_cb = rotate_tile_16;
+            break;
+        case 4:
+            tile_cb = rotate_tile_32;
+            break;
+        default:
+            LV_LOG_WARN("unsupported pixel size: %d", px_size);
+            return;
+    }
+
+    /*Walk the source in square tiles so that the rows of a tile stay in the cache
+     *while they are written column by column to the destination.
+     *`dest_step` is the distance between the destination rows of two neighboring source columns.*/
+    bool is_270 = rotation == LV_DISP_ROT_270;
+    lv_coord_t dest_step = is_270 ? dest_stride : -dest_stride;
+    lv_coord_t tile = ROTATE_TILE_SIZE(px_size);
+    lv_coord_t ty;
+    for(ty = 0; ty < src_h; ty += tile) {
+        lv_coord_t th = LV_MIN(tile, src_h - ty);
+        lv_coord_t tx;
+        for(tx = 0; tx < src_w; tx += tile) {
+            lv_coord_t tw = LV_MIN(tile, src_w - tx);
+            /*Destination of the tile's top left pixel*/
+            int32_t dest_ofs;
+            if(is_270) dest_ofs = (int32_t)tx * dest_stride + (src_h - 1 - ty);
+            else dest_ofs = (int32_t)(src_w - 1 - tx) * dest_stride + ty;
+
+            tile_cb(src8 + ((int32_t)ty * src_stride + tx) * px_size, src_stride,
+                    dest8 + dest_ofs * px_size, dest_step, tw, th, is_270);
+        }
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Rotate a tile of 8 bit pixels by 90 or 270 degrees.
+ * @param src           pointer to the tile's top left pixel
+ * @param src_stride    distance between the source rows in pixels
+ * @param dest          destination of the tile's top left pixel
+ * @param dest_step     distance between the destination rows of two neighboring source columns in pixels
+ * @param w             width of the tile
+ * @param h             height of the tile
+ * @param is_270        true: the source rows are written right to left; false: left to right
+ */
+static void LV_ATTRIBUTE_FAST_MEM rotate_tile_8(const uint8_t * src, lv_coord_t src_stride, uint8_t * dest,
+                                                lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270)
+{
+    int32_t dest_inc = is_270 ? -1 : 1;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(x = 0; x < w; x++) {
+        const uint8_t * s = src + x;
+        uint8_t * d = dest + (int32_t)x * dest_step;
+        for(y = 0; y < h; y++) {
+            *d = *s;
+            s += src_stride;
+            d += dest_inc;
+        }
+    }
+}
+
+/**
+ * Rotate a tile of 16 bit pixels by 90 or 270 degrees.
+ * The parameters are the same as in `rotate_tile_8`.
+ */
+static void LV_ATTRIBUTE_FAST_MEM rotate_tile_16(const uint8_t * src8, lv_coord_t src_stride, uint8_t * dest8,
+                                                 lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270)
+{
+    const uint16_t * src = (const uint16_t *)src8;
+    uint16_t * dest = (uint16_t *)dest8;
+
+#if ROTATE_VECTOR
+    /*Transpose 8x8 blocks in registers and write them as 8 pixel wide rows*/
+    lv_coord_t w8 = w & ~7;
+    lv_coord_t h8 = h & ~7;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h8; y += 8) {
+        for(x = 0; x < w8; x += 8) {
+            rotate_v8u16_t r[8];
+            lv_coord_t i;
+            for(i = 0; i < 8; i++) {
+                __builtin_memcpy(&r[i], src + (int32_t)(y + i) * src_stride + x, sizeof(rotate_v8u16_t));
+            }
+
+            rotate_v8u16_t a[8];
+            for(i = 0; i < 8; i += 2) {
+                a[i] = ROTATE_SHUFFLE(rotate_v8u16_t, r[i], r[i + 1], 0, 8, 1, 9, 2, 10, 3, 11);
+                a[i + 1] = ROTATE_SHUFFLE(rotate_v8u16_t, r[i], r[i + 1], 4, 12, 5, 13, 6, 14, 7, 15);
+            }
+
+            rotate_v8u16_t b[8];
+            for(i = 0; i < 8; i += 4) {
+                b[i] = ROTATE_SHUFFLE(rotate_v8u16_t, a[i], a[i + 2], 0, 1, 8, 9, 2, 3, 10, 11);
+                b[i + 1] = ROTATE_SHUFFLE(rotate_v8u16_t, a[i], a[i + 2], 4, 5, 12, 13, 6, 7, 14, 15);
+                b[i + 2] = ROTATE_SHUFFLE(rotate_v8u16_t, a[i + 1], a[i + 3], 0, 1, 8, 9, 2, 3, 10, 11);
+                b[i + 3] = ROTATE_SHUFFLE(rotate_v8u16_t, a[i + 1], a[i + 3], 4, 5, 12, 13, 6, 7, 14, 15);
+            }
+
+            /*c[i] is the column `x + i` of the block*/
+            rotate_v8u16_t c[8];
+            for(i = 0; i < 4; i++) {
+                c[i * 2] = ROTATE_SHUFFLE(rotate_v8u16_t, b[i], b[i + 4], 0, 1, 2, 3, 8, 9, 10, 11);
+                c[i * 2 + 1] = ROTATE_SHUFFLE(rotate_v8u16_t, b[i], b[i + 4], 4, 5, 6, 7, 12, 13, 14, 15);
+            }
+
+            for(i = 0; i < 8; i++) {
+                uint16_t * d = dest + (int32_t)(x + i) * dest_step;
+                if(is_270) {
+                    c[i] = ROTATE_SHUFFLE(rotate_v8u16_t, c[i], c[i], 7, 6, 5, 4, 3, 2, 1, 0);
+                    d -= y + 7;
+                }
+                else {
+                    d += y;
+                }
+                __builtin_memcpy(d, &c[i], sizeof(rotate_v8u16_t));
+            }
+        }
+    }
+
+    /*Rotate the right and bottom stripes pixel by pixel*/
+    if(w8 < w) rotate_tile_16_scalar(src + w8, src_stride, dest + (int32_t)w8 * dest_step, dest_step, w - w8, h8, is_270);
+    src += (int32_t)h8 * src_stride;
+    dest += is_270 ? -h8 : h8;
+    h -= h8;
+#endif
+
+    rotate_tile_16_scalar(src, src_stride, dest, dest_step, w, h, is_270);
+}
+
+/**
+ * Rotate a tile of 32 bit pixels by 90 or 270 degrees.
+ * The parameters are the same as in `rotate_tile_8`.
+ */
+static void LV_ATTRIBUTE_FAST_MEM rotate_tile_32(const uint8_t * src8, lv_coord_t src_stride, uint8_t * dest8,
+                                                 lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270)
+{
+    const uint32_t * src = (const uint32_t *)src8;
+    uint32_t * dest = (uint32_t *)dest8;
+
+#if ROTATE_VECTOR
+    /*Transpose 4x4 blocks in registers and write them as 4 pixel wide rows*/
+    lv_coord_t w4 = w & ~3;
+    lv_coord_t h4 = h & ~3;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h4; y += 4) {
+        for(x = 0; x < w4; x += 4) {
+            rotate_v4u32_t r[4];
+            lv_coord_t i;
+            for(i = 0; i < 4; i++) {
+                __builtin_memcpy(&r[i], src + (int32_t)(y + i) * src_stride + x, sizeof(rotate_v4u32_t));
+            }
+
+            rotate_v4u32_t a[4];
+            a[0] = ROTATE_SHUFFLE(rotate_v4u32_t, r[0], r[1], 0, 4, 1, 5);
+            a[1] = ROTATE_SHUFFLE(rotate_v4u32_t, r[0], r[1], 2, 6, 3, 7);
+            a[2] = ROTATE_SHUFFLE(rotate_v4u32_t, r[2], r[3], 0, 4, 1, 5);
+            a[3] = ROTATE_SHUFFLE(rotate_v4u32_t, r[2], r[3], 2, 6, 3, 7);
+
+            /*c[i] is the column `x + i` of the block*/
+            rotate_v4u32_t c[4];
+            c[0] = ROTATE_SHUFFLE(rotate_v4u32_t, a[0], a[2], 0, 1, 4, 5);
+            c[1] = ROTATE_SHUFFLE(rotate_v4u32_t, a[0], a[2], 2, 3, 6, 7);
+            c[2] = ROTATE_SHUFFLE(rotate_v4u32_t, a[1], a[3], 0, 1, 4, 5);
+            c[3] = ROTATE_SHUFFLE(rotate_v4u32_t, a[1], a[3], 2, 3, 6, 7);
+
+            for(i = 0; i < 4; i++) {
+                uint32_t * d = dest + (int32_t)(x + i) * dest_step;
+                if(is_270) {
+                    c[i] = ROTATE_SHUFFLE(rotate_v4u32_t, c[i], c[i], 3, 2, 1, 0);
+                    d -= y + 3;
+                }
+                else {
+                    d += y;
+                }
+                __builtin_memcpy(d, &c[i], sizeof(rotate_v4u32_t));
+            }
+        }
+    }
+
+    /*Rotate the right and bottom stripes pixel by pixel*/
+    if(w4 < w) rotate_tile_32_scalar(src + w4, src_stride, dest + (int32_t)w4 * dest_step, dest_step, w - w4, h4, is_270);
+    src += (int32_t)h4 * src_stride;
+    dest += is_270 ? -h4 : h4;
+    h -= h4;
+#endif
+
+    rotate_tile_32_scalar(src, src_stride, dest, dest_step, w, h, is_270);
+}
+
+static inline void rotate_tile_16_scalar(const uint16_t * src, lv_coord_t src_stride, uint16_t * dest,
+                                         lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270)
+{
+    int32_t dest_inc = is_270 ? -1 : 1;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(x = 0; x < w; x++) {
+        const uint16_t * s = src + x;
+        uint16_t * d = dest + (int32_t)x * dest_step;
+        for(y = 0; y < h; y++) {
+            *d = *s;
+            s += src_stride;
+            d += dest_inc;
+        }
+    }
+}
+
+static inline void rotate_tile_32_scalar(const uint32_t * src, lv_coord_t src_stride, uint32_t * dest,
+                                         lv_coord_t dest_step, lv_coord_t w, lv_coord_t h, bool is_270)
+{
+    int32_t dest_inc = is_270 ? -1 : 1;
+    lv_coord_t x;
+    lv_coord_t y;
+    for(x = 0; x < w; x++) {
+        const uint32_t * s = src + x;
+        uint32_t * d = dest + (int32_t)x * dest_step;
+        for(y = 0; y < h; y++) {
+            *d = *s;
+            s += src_stride;
+            d += dest_inc;
+        }
+    }
+}
+
+/**
+ * Rotate an image by 180 degrees.
+ * `src` and `dest` can be the same buffer if the strides are equal too.
+ * @param src           pointer to the source image
+ * @param dest          pointer to the destination
+ * @param src_w         width of the image
+ * @param src_h         height of the image
+ * @param src_stride    distance between the source rows in pixels
+ * @param dest_stride   distance between the destination rows in pixels
+ * @param px_size       size of a pixel in bytes (1, 2 or 4)
+ */
+static void LV_ATTRIBUTE_FAST_MEM rotate_180(const uint8_t * src, uint8_t * dest, lv_coord_t src_w, lv_coord_t src_h,
+                                             lv_coord_t src_stride, lv_coord_t dest_stride, uint8_t px_size)
+{
+    /*Swap the pixels of the rows `y` and `src_h - 1 - y` mirrored. Reading both pixels before
+     *writing them makes the in-place rotation work too.*/
+#define ROTATE_180_ROWS(type)                                                                    \
+    do {                                                                                         \
+        lv_coord_t y;                                                                            \
+        for(y = 0; y < (src_h + 1) / 2; y++) {                                                   \
+            const type * s_top = (const type *)src + (int32_t)y * src_stride;                    \
+            const type * s_bottom = (const type *)src + (int32_t)(src_h - 1 - y) * src_stride;   \
+            type * d_top = (type *)dest + (int32_t)y * dest_stride;                              \
+            type * d_bottom = (type *)dest + (int32_t)(src_h - 1 - y) * dest_stride;             \
+            /*The middle row is swapped with itself, stop in the middle of it*/                  \
+            lv_coord_t x_end = (y == src_h - 1 - y) ? (src_w + 1) / 2 : src_w;                   \
+            lv_coord_t x;                                                                        \
+            for(x = 0; x < x_end; x++) {                                                         \
+                type top = s_top[x];                                                             \
+                type bottom = s_bottom[src_w - 1 - x];                                           \
+                d_top[x] = bottom;                                                               \
+                d_bottom[src_w - 1 - x] = top;                                                   \
+            }                                                                                    \
+        }                                                                                        \
+    } while(0)
+
+    switch(px_size) {
+        case 1:
+            ROTATE_180_ROWS(uint8_t);
+            break;
+        case 2:
+            ROTATE_180_ROWS(uint16_t);
+            break;
+        case 4:
+            ROTATE_180_ROWS(uint32_t);
+            break;
+        default:
+            LV_LOG_WARN("unsupported pixel size: %d", px_size);
+            break;
+    }
+
+#undef ROTATE_180_ROWS
+}
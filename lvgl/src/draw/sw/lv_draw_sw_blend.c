@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_sw.h"
+#include "lv_draw_sw_blend_simd.h"
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
@@ -26,15 +27,15 @@
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide);
 
-static void /* LV_ATTRIBUTE_FAST_MEM */ fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
-                                                    lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
-                                                    const lv_opa_t * mask, lv_coord_t mask_stride);
+static void LV_ATTRIBUTE_FAST_MEM fill_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                              lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                              const lv_opa_t * mask, lv_coord_t mask_stride);
 
 
 #if LV_COLOR_SCREEN_TRANSP
-static void /* LV_ATTRIBUTE_FAST_MEM */ fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
-                                                  lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
-                                                  const lv_opa_t * mask, lv_coord_t mask_stride);
+static void LV_ATTRIBUTE_FAST_MEM fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                            lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                            const lv_opa_t * mask, lv_coord_t mask_stride);
 #endif /*LV_COLOR_SCREEN_TRANSP*/
 
 #if LV_DRAW_COMPLEX
@@ -46,16 +47,16 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
                        const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
                        const lv_opa_t * mask, lv_coord_t mask_stride);
 
-static void /* LV_ATTRIBUTE_FAST_MEM */ map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
-                                                   lv_coord_t dest_stride, const lv_color_t * src_buf,
-                                                   lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
-                                                   lv_coord_t mask_stride);
+static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                             lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                             lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                             lv_coord_t mask_stride);
 
 #if LV_COLOR_SCREEN_TRANSP
-static void /* LV_ATTRIBUTE_FAST_MEM */ map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
-                                                 lv_coord_t dest_stride, const lv_color_t * src_buf,
-                                                 lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
-                                                 lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
+static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                           lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                           lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                           lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
 
 #endif /*LV_COLOR_SCREEN_TRANSP*/
 
@@ -69,6 +70,24 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 #endif /*LV_DRAW_COMPLEX*/
 
+static void blend_rot_270(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc, const lv_area_t * blend_area,
+                          const lv_color_t * src_buf, lv_coord_t src_stride, const lv_opa_t * mask, lv_coord_t mask_stride);
+
+static void LV_ATTRIBUTE_FAST_MEM fill_normal_rot_270(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                      lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                      const lv_opa_t * mask, lv_coord_t mask_stride);
+
+static void LV_ATTRIBUTE_FAST_MEM map_normal_rot_270(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                     lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                     lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                     lv_coord_t mask_stride);
+
+#if LV_DRAW_COMPLEX
+static void blended_rot_270(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                            lv_color_t color, const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                            const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
+#endif /*LV_DRAW_COMPLEX*/
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -167,6 +186,10 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
 
     lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
 
+    if(draw_ctx->buf_rot_270) {
+        blend_rot_270(draw_ctx, dsc, &blend_area, src_buf, src_stride, mask, mask_stride);
+        return;
+    }
 
     if(disp->driver->set_px_cb) {
         if(dsc->src_buf == NULL) {
@@ -211,6 +234,39 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Blend to a buffer stored rotated by 270 degrees (see `lv_draw_ctx_t::buf_rot_270`).
+ * The columns of the area are written from right to left as the rows of the buffer
+ * so the buffer is written sequentially and there is no need to rotate it later.
+ * `set_px_cb` and `screen_transp` are not supported.
+ */
+static void blend_rot_270(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc, const lv_area_t * blend_area,
+                          const lv_color_t * src_buf, lv_coord_t src_stride, const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    /*The rows of the buffer are as long as the columns of `buf_area`*/
+    lv_coord_t dest_stride = lv_area_get_height(draw_ctx->buf_area);
+    lv_coord_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+
+    /*The top right pixel of the blend area is the first pixel of the first row in the buffer*/
+    lv_color_t * dest_buf = draw_ctx->buf;
+    dest_buf += dest_stride * (buf_w - 1 - blend_area->x2) + blend_area->y1;
+
+    if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
+        if(src_buf == NULL) {
+            fill_normal_rot_270(dest_buf, blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride);
+        }
+        else {
+            map_normal_rot_270(dest_buf, blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride);
+        }
+    }
+    else {
+#if LV_DRAW_COMPLEX
+        blended_rot_270(dest_buf, blend_area, dest_stride, dsc->color, src_buf, src_stride, dsc->opa, mask, mask_stride,
+                        dsc->blend_mode);
+#endif
+    }
+}
+
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide)
 {
@@ -280,7 +336,7 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
             lv_opa_t opa_inv = 255 - opa;
 
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
+                for(x = blend_simd_fill_premult(dest_buf, color_premult, opa_inv, w); x < w; x++) {
                     if(last_dest_color.full != dest_buf[x].full) {
                         last_dest_color = dest_buf[x];
                         last_res_color = lv_color_mix_premult(color_premult, dest_buf[x], opa_inv);
@@ -304,6 +360,12 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
                     FILL_NORMAL_MASK_PX(color)
                 }
 
+                /*Start from the aligned mask to skip the same transparent mask words as the loop below*/
+                int32_t simd_cnt = blend_simd_fill_mask(dest_buf, color, mask, opa, w - x);
+                x += simd_cnt;
+                dest_buf += simd_cnt;
+                mask += simd_cnt;
+
                 for(; x <= x_end4; x += 4) {
                     uint32_t mask32 = *((uint32_t *)mask);
                     if(mask32 == 0xFFFFFFFF) {
@@ -358,7 +420,9 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
             lv_opa_t opa_tmp = LV_OPA_TRANSP;
 
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
+                x = blend_simd_fill_mask(dest_buf, color, mask, opa, w);
+                mask += x;
+                for(; x < w; x++) {
                     if(*mask) {
                         if(*mask != last_mask) opa_tmp = *mask == LV_OPA_COVER ? opa :
                                                              (uint32_t)((uint32_t)(*mask) * opa) >> 8;
@@ -409,10 +473,10 @@ static inline void set_px_argb(uint8_t * buf, lv_color_t color, lv_opa_t opa)
 static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t opa, lv_color_t (*blend_fp)(lv_color_t,
                                                                                                            lv_color_t, lv_opa_t))
 {
-    static lv_color_t last_dest_color;
-    static lv_color_t last_src_color;
-    static lv_color_t last_res_color;
-    static uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
+    static LV_THREAD_LOCAL lv_color_t last_dest_color;
+    static LV_THREAD_LOCAL lv_color_t last_src_color;
+    static LV_THREAD_LOCAL lv_color_t last_res_color;
+    static LV_THREAD_LOCAL uint32_t last_opa = 0xffff; /*Set to an invalid value for first*/
 
     lv_color_t bg_color;
 
@@ -568,7 +632,7 @@ static void fill_blended(lv_color_t * dest_buf, const lv_area_t * dest_area,
         lv_color_t last_dest_color = dest_buf[0];
         lv_color_t last_res_color = blend_fp(color, dest_buf[0], opa);
         for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x++) {
+            for(x = blend_simd_fill_blended(dest_buf, color, NULL, opa, blend_mode, w); x < w; x++) {
                 if(last_dest_color.full != dest_buf[x].full) {
                     last_dest_color = dest_buf[x];
                     last_res_color = blend_fp(color, dest_buf[x], opa);
@@ -589,7 +653,7 @@ static void fill_blended(lv_color_t * dest_buf, const lv_area_t * dest_area,
         last_res_color = blend_fp(color, last_dest_color, opa_tmp);
 
         for(y = 0; y < h; y++) {
-            for(x = 0; x < w; x++) {
+            for(x = blend_simd_fill_blended(dest_buf, color, mask, opa, blend_mode, w); x < w; x++) {
                 if(mask[x] == 0) continue;
                 if(mask[x] != last_mask || last_dest_color.full != dest_buf[x].full) {
                     opa_tmp = mask[x] >= LV_OPA_MAX ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
@@ -666,7 +730,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
         }
         else {
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
+                for(x = blend_simd_map(dest_buf, src_buf, NULL, opa, w); x < w; x++) {
                     dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
                 }
                 dest_buf += dest_stride;
@@ -687,7 +751,10 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
                     MAP_NORMAL_MASK_PX(x);
                 }
 #else
-                for(x = 0; x < w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
+                x = blend_simd_map(dest_buf, src_buf, mask, opa, w);
+                mask_tmp_x += x;
+
+                for(; x < w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
                     MAP_NORMAL_MASK_PX(x)
                 }
 
@@ -724,7 +791,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
         /*Handle opa and mask values too*/
         else {
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
+                for(x = blend_simd_map(dest_buf, src_buf, mask, opa, w); x < w; x++) {
                     if(mask[x]) {
                         lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
                         dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
@@ -739,6 +806,154 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
 }
 
 
+/**
+ * Same as `fill_normal` but `dest_buf` is rotated by 270 degrees.
+ * `dest_buf` points to the top right pixel of the area, `dest_stride` is the stride of the rotated buffer.
+ */
+static void LV_ATTRIBUTE_FAST_MEM fill_normal_rot_270(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                      lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa,
+                                                      const lv_opa_t * mask, lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
+    /*No mask*/
+    if(mask == NULL) {
+        if(opa >= LV_OPA_MAX) {
+            for(x = w - 1; x >= 0; x--) {
+                lv_color_fill(dest_buf, color, h);
+                dest_buf += dest_stride;
+            }
+        }
+        /*Has opacity*/
+        else {
+            lv_color_t last_dest_color = lv_color_black();
+            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+
+#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
+            /*Introduce the same rounding error as `fill_normal`*/
+            opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+            opa = opa << 3;
+#endif
+
+            uint16_t color_premult[3];
+            lv_color_premult(color, opa, color_premult);
+            lv_opa_t opa_inv = 255 - opa;
+
+            for(x = w - 1; x >= 0; x--) {
+                for(y = blend_simd_fill_premult(dest_buf, color_premult, opa_inv, h); y < h; y++) {
+                    if(last_dest_color.full != dest_buf[y].full) {
+                        last_dest_color = dest_buf[y];
+                        last_res_color = lv_color_mix_premult(color_premult, dest_buf[y], opa_inv);
+                    }
+                    dest_buf[y] = last_res_color;
+                }
+                dest_buf += dest_stride;
+            }
+        }
+    }
+    /*Masked*/
+    else {
+        const lv_opa_t * mask_tmp;
+
+        /*Only the mask matters*/
+        if(opa >= LV_OPA_MAX) {
+            for(x = w - 1; x >= 0; x--) {
+                mask_tmp = mask + x;
+                for(y = 0; y < h; y++) {
+                    if(*mask_tmp == LV_OPA_COVER) dest_buf[y] = color;
+                    else if(*mask_tmp) dest_buf[y] = lv_color_mix(color, dest_buf[y], *mask_tmp);
+                    mask_tmp += mask_stride;
+                }
+                dest_buf += dest_stride;
+            }
+        }
+        /*With opacity*/
+        else {
+            for(x = w - 1; x >= 0; x--) {
+                mask_tmp = mask + x;
+                for(y = 0; y < h; y++) {
+                    if(*mask_tmp) {
+                        lv_opa_t opa_tmp = *mask_tmp == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)(*mask_tmp) * opa) >> 8;
+                        dest_buf[y] = lv_color_mix(color, dest_buf[y], opa_tmp);
+                    }
+                    mask_tmp += mask_stride;
+                }
+                dest_buf += dest_stride;
+            }
+        }
+    }
+}
+
+/**
+ * Same as `map_normal` but `dest_buf` is rotated by 270 degrees.
+ * `dest_buf` points to the top right pixel of the area, `dest_stride` is the stride of the rotated buffer.
+ */
+static void LV_ATTRIBUTE_FAST_MEM map_normal_rot_270(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                                     lv_coord_t dest_stride, const lv_color_t * src_buf,
+                                                     lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
+                                                     lv_coord_t mask_stride)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
+    const lv_color_t * src_tmp;
+
+    /*Simple fill (maybe with opacity), no masking*/
+    if(mask == NULL) {
+        for(x = w - 1; x >= 0; x--) {
+            src_tmp = src_buf + x;
+            if(opa >= LV_OPA_MAX) {
+                for(y = 0; y < h; y++) {
+                    dest_buf[y] = *src_tmp;
+                    src_tmp += src_stride;
+                }
+            }
+            else {
+                for(y = 0; y < h; y++) {
+                    dest_buf[y] = lv_color_mix(*src_tmp, dest_buf[y], opa);
+                    src_tmp += src_stride;
+                }
+            }
+            dest_buf += dest_stride;
+        }
+    }
+    /*Masked*/
+    else {
+        const lv_opa_t * mask_tmp;
+        for(x = w - 1; x >= 0; x--) {
+            src_tmp = src_buf + x;
+            mask_tmp = mask + x;
+            /*Only the mask matters*/
+            if(opa > LV_OPA_MAX) {
+                for(y = 0; y < h; y++) {
+                    if(*mask_tmp == LV_OPA_COVER) dest_buf[y] = *src_tmp;
+                    else if(*mask_tmp) dest_buf[y] = lv_color_mix(*src_tmp, dest_buf[y], *mask_tmp);
+                    src_tmp += src_stride;
+                    mask_tmp += mask_stride;
+                }
+            }
+            /*Handle opa and mask values too*/
+            else {
+                for(y = 0; y < h; y++) {
+                    if(*mask_tmp) {
+                        lv_opa_t opa_tmp = *mask_tmp >= LV_OPA_MAX ? opa : ((opa * (*mask_tmp)) >> 8);
+                        dest_buf[y] = lv_color_mix(*src_tmp, dest_buf[y], opa_tmp);
+                    }
+                    src_tmp += src_stride;
+                    mask_tmp += mask_stride;
+                }
+            }
+            dest_buf += dest_stride;
+        }
+    }
+}
 
 #if LV_COLOR_SCREEN_TRANSP
 static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
@@ -807,7 +1022,9 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
             uint8_t * dest_buf8_row = dest_buf8;
             for(y = 0; y < h; y++) {
                 if(blend_fp == NULL) {
-                    for(x = 0; x < w; x++) {
+                    x = blend_simd_map_argb(dest_buf8, src_buf, NULL, opa, false, w);
+                    dest_buf8 += x * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                    for(; x < w; x++) {
                         set_px_argb(dest_buf8, src_buf[x], opa);
                         dest_buf8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
                     }
@@ -832,7 +1049,9 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
             uint8_t * dest_buf8_row = dest_buf8;
             for(y = 0; y < h; y++) {
                 if(blend_fp == NULL) {
-                    for(x = 0; x < w; x++) {
+                    x = blend_simd_map_argb(dest_buf8, src_buf, mask, opa, true, w);
+                    dest_buf8 += x * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                    for(; x < w; x++) {
                         set_px_argb(dest_buf8, src_buf[x], mask[x]);
                         dest_buf8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
                     }
@@ -854,7 +1073,9 @@ static void LV_ATTRIBUTE_FAST_MEM map_argb(lv_color_t * dest_buf, const lv_area_
             uint8_t * dest_buf8_row = dest_buf8;
             for(y = 0; y < h; y++) {
                 if(blend_fp == NULL) {
-                    for(x = 0; x < w; x++) {
+                    x = blend_simd_map_argb(dest_buf8, src_buf, mask, opa, false, w);
+                    dest_buf8 += x * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                    for(; x < w; x++) {
                         if(mask[x]) {
                             lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
                             set_px_argb(dest_buf8, src_buf[x], opa_tmp);
@@ -955,6 +1176,52 @@ static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_c
     }
 }
 
+/**
+ * Same as `fill_blended` and `map_blended` (with `src_buf != NULL`) but `dest_buf` is rotated by 270 degrees.
+ * `dest_buf` points to the top right pixel of the area, `dest_stride` is the stride of the rotated buffer.
+ */
+static void blended_rot_270(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                            lv_color_t color, const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                            const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+
+    lv_color_t (*blend_fp)(lv_color_t, lv_color_t, lv_opa_t);
+    switch(blend_mode) {
+        case LV_BLEND_MODE_ADDITIVE:
+            blend_fp = color_blend_true_color_additive;
+            break;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            blend_fp = color_blend_true_color_subtractive;
+            break;
+        case LV_BLEND_MODE_MULTIPLY:
+            blend_fp = color_blend_true_color_multiply;
+            break;
+        default:
+            LV_LOG_WARN("blended_rot_270: unsupported blend mode");
+            return;
+    }
+
+    for(x = w - 1; x >= 0; x--) {
+        for(y = 0; y < h; y++) {
+            lv_opa_t opa_tmp = opa;
+            if(mask) {
+                lv_opa_t mask_px = mask[y * mask_stride + x];
+                if(mask_px == 0) continue;
+                if(mask_px < LV_OPA_MAX) opa_tmp = (uint32_t)((uint32_t)mask_px * opa) >> 8;
+            }
+
+            lv_color_t color_px = src_buf ? src_buf[y * src_stride + x] : color;
+            dest_buf[y] = blend_fp(color_px, dest_buf[y], opa_tmp);
+        }
+        dest_buf += dest_stride;
+    }
+}
+
 static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color_t bg, lv_opa_t opa)
 {
 
@@ -56,6 +56,9 @@ CSRCS += lv_tabview.c
 CSRCS += lv_tileview.c
 CSRCS += lv_win.c
 CSRCS += lv_video.c
+CSRCS += lv_video_yuv.c
+CSRCS += lv_video_index.c
+CSRCS += lv_video_reader.c
 CSRCS += lv_zh_keyboard.c
 
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/extra
@@ -0,0 +1,434 @@
+/**
+ * @file lv_video_reader.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_video_reader.h"
+
+#if LV_USE_VIDEO != 0
+
+#include "../../../misc/lv_mem.h"
+#include "../../../misc/lv_log.h"
+#include "../../../misc/lv_math.h"
+#include <stdlib.h>
+
+#if LV_VIDEO_READ_AHEAD_CNT > 0
+    #if LV_USE_GUIDER_SIMULATOR
+        #include <pthread.h>
+    #else
+        #include "FreeRTOS.h"
+        #include "task.h"
+        #include "semphr.h"
+    #endif
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_VIDEO_READER_TASK_STACK_SIZE
+    #define LV_VIDEO_READER_TASK_STACK_SIZE (2 * 1024)
+#endif
+#ifndef LV_VIDEO_READER_TASK_PRIORITY
+    /*Above the decode task to start the next read as soon as a buffer is free. It sleeps while the card reads.*/
+    #define LV_VIDEO_READER_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
+#endif
+
+/*Who waits: the worker for a free buffer or the reader for a filled one*/
+#define WAITER_WORKER   0
+#define WAITER_READER   1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_VIDEO_READ_AHEAD_CNT > 0
+typedef struct {
+#if LV_USE_GUIDER_SIMULATOR
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond[2];
+#else
+    SemaphoreHandle_t sem[2];
+    volatile bool running;
+#endif
+} reader_os_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void reader_work(lv_video_reader_t * reader);
+static bool reader_os_create(lv_video_reader_t * reader);
+static void reader_os_delete(lv_video_reader_t * reader);
+static void reader_lock(lv_video_reader_t * reader);
+static void reader_unlock(lv_video_reader_t * reader);
+static void reader_wait(lv_video_reader_t * reader, int waiter);
+static void reader_wake(lv_video_reader_t * reader, int waiter);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+#if LV_VIDEO_READ_AHEAD_CNT > 0
+
+lv_res_t lv_video_reader_open(lv_video_reader_t * reader, lv_fs_file_t * file, uint32_t pos)
+{
+    lv_memset_00(reader, sizeof(lv_video_reader_t));
+    reader->file = file;
+    reader->next_pos = pos;
+    reader->res = LV_FS_RES_OK;
+
+    /*The decode thread and the worker free them, the LVGL heap is not thread safe*/
+    uint32_t i;
+    for(i = 0; i < LV_VIDEO_READ_AHEAD_CNT; i++) {
+        reader->bufs[i].data = malloc(LV_VIDEO_READ_AHEAD_SIZE);
+        if(reader->bufs[i].data == NULL) break;
+    }
+
+    if(i < LV_VIDEO_READ_AHEAD_CNT || !reader_os_create(reader)) {
+        for(i = 0; i < LV_VIDEO_READ_AHEAD_CNT; i++) free(reader->bufs[i].data);
+        lv_memset_00(reader, sizeof(lv_video_reader_t));
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+void lv_video_reader_close(lv_video_reader_t * reader)
+{
+    if(reader->os == NULL) return;
+
+    reader_lock(reader);
+    reader->stop = true;
+    reader_unlock(reader);
+    reader_wake(reader, WAITER_WORKER);
+
+    /*Waits for the read in progress*/
+    reader_os_delete(reader);
+
+    uint32_t i;
+    for(i = 0; i < LV_VIDEO_READ_AHEAD_CNT; i++) free(reader->bufs[i].data);
+    lv_memset_00(reader, sizeof(lv_video_reader_t));
+}
+
+lv_fs_res_t lv_video_reader_read(lv_video_reader_t * reader, void * buf, uint32_t btr, uint32_t * br)
+{
+    uint8_t * dst = buf;
+    lv_fs_res_t res = LV_FS_RES_OK;
+
+    *br = 0;
+    while(*br < btr) {
+        reader_lock(reader);
+        while(reader->filled == 0 && !reader->eof && reader->res == LV_FS_RES_OK) {
+            reader_wait(reader, WAITER_READER);
+        }
+        if(reader->filled == 0) {
+            /*Return the data before the error first*/
+            if(*br == 0) res = reader->res;
+            reader_unlock(reader);
+            break;
+        }
+        reader_unlock(reader);
+
+        /*The worker doesn't touch the filled buffers*/
+        lv_video_reader_buf_t * b = &reader->bufs[reader->rd];
+        uint32_t n = LV_MIN(b->len - reader->rd_ofs, btr - *br);
+        lv_memcpy(dst + *br, b->data + reader->rd_ofs, n);
+        *br += n;
+        reader->rd_ofs += n;
+
+        if(reader->rd_ofs == b->len) {
+            reader_lock(reader);
+            reader->rd = (reader->rd + 1) % LV_VIDEO_READ_AHEAD_CNT;
+            reader->filled--;
+            reader->rd_ofs = 0;
+            reader_unlock(reader);
+            reader_wake(reader, WAITER_WORKER);
+        }
+    }
+
+    return res;
+}
+
+void lv_video_reader_seek(lv_video_reader_t * reader, uint32_t pos)
+{
+    reader_lock(reader);
+
+    /*Drop the blocks before the position, e.g. skipped forward, and keep the rest*/
+    reader->rd_ofs = 0;
+    while(reader->filled > 0) {
+        lv_video_reader_buf_t * b = &reader->bufs[reader->rd];
+        if(pos >= b->pos && pos < b->pos + b->len) {
+            reader->rd_ofs = pos - b->pos;
+            reader_unlock(reader);
+            reader_wake(reader, WAITER_WORKER);
+            return;
+        }
+        reader->rd = (reader->rd + 1) % LV_VIDEO_READ_AHEAD_CNT;
+        reader->filled--;
+    }
+
+    /*Not read ahead: restart from the position. The block being read is dropped.*/
+    reader->next_pos = pos;
+    reader->gen++;
+    reader->eof = false;
+    reader->res = LV_FS_RES_OK;
+    reader_unlock(reader);
+    reader_wake(reader, WAITER_WORKER);
+}
+
+#else /*LV_VIDEO_READ_AHEAD_CNT*/
+
+/*Without read-ahead the file is read directly*/
+
+lv_res_t lv_video_reader_open(lv_video_reader_t * reader, lv_fs_file_t * file, uint32_t pos)
+{
+    reader->file = file;
+    lv_fs_seek(file, pos, LV_FS_SEEK_SET);
+    return LV_RES_OK;
+}
+
+void lv_video_reader_close(lv_video_reader_t * reader)
+{
+    reader->file = NULL;
+}
+
+lv_fs_res_t lv_video_reader_read(lv_video_reader_t * reader, void * buf, uint32_t btr, uint32_t * br)
+{
+    return lv_fs_read(reader->file, buf, btr, br);
+}
+
+void lv_video_reader_seek(lv_video_reader_t * reader, uint32_t pos)
+{
+    lv_fs_seek(reader->file, pos, LV_FS_SEEK_SET);
+}
+
+#endif /*LV_VIDEO_READ_AHEAD_CNT*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_VIDEO_READ_AHEAD_CNT > 0
+
+/**
+ * Fill the free buffers until the end of the file. It's the body of the worker thread and returns when closed.
+ * @param reader pointer to a reader
+ */
+static void reader_work(lv_video_reader_t * reader)
+{
+    /*Seek before the first read, the file might be elsewhere*/
+    uint32_t file_pos = UINT32_MAX;
+
+    reader_lock(reader);
+    while(!reader->stop) {
+        if(reader->filled == LV_VIDEO_READ_AHEAD_CNT || reader->eof || reader->res != LV_FS_RES_OK) {
+            reader_wait(reader, WAITER_WORKER);
+            continue;
+        }
+
+        /*The slot after the filled ones stays the same while reading: the reader only empties buffers before it*/
+        lv_video_reader_buf_t * b = &reader->bufs[(reader->rd + reader->filled) % LV_VIDEO_READ_AHEAD_CNT];
+        uint32_t pos = reader->next_pos;
+        uint32_t gen = reader->gen;
+        reader_unlock(reader);
+
+        lv_fs_res_t res = LV_FS_RES_OK;
+        uint32_t br = 0;
+        if(pos != file_pos) res = lv_fs_seek(reader->file, pos, LV_FS_SEEK_SET);
+        if(res == LV_FS_RES_OK) res = lv_fs_read(reader->file, b->data, LV_VIDEO_READ_AHEAD_SIZE, &br);
+        file_pos = res == LV_FS_RES_OK ? pos + br : UINT32_MAX;
+
+        reader_lock(reader);
+        /*Dropped if the reader seeked meanwhile*/
+        if(gen != reader->gen) continue;
+
+        if(res != LV_FS_RES_OK) {
+            LV_LOG_WARN("read error %d at %d", res, pos);
+            reader->res = res;
+        }
+        else {
+            if(br > 0) {
+                b->pos = pos;
+                b->len = br;
+                reader->filled++;
+                reader->next_pos = pos + br;
+            }
+            if(br < LV_VIDEO_READ_AHEAD_SIZE) reader->eof = true;
+        }
+        reader_unlock(reader);
+        reader_wake(reader, WAITER_READER);
+        reader_lock(reader);
+    }
+    reader_unlock(reader);
+}
+
+#if LV_USE_GUIDER_SIMULATOR
+
+static void * reader_thread(void * param)
+{
+    reader_work(param);
+    return NULL;
+}
+
+static bool reader_os_create(lv_video_reader_t * reader)
+{
+    reader_os_t * os = malloc(sizeof(reader_os_t));
+    if(os == NULL) return false;
+
+    pthread_mutex_init(&os->mutex, NULL);
+    pthread_cond_init(&os->cond[WAITER_WORKER], NULL);
+    pthread_cond_init(&os->cond[WAITER_READER], NULL);
+    reader->os = os;
+
+    if(pthread_create(&os->thread, NULL, reader_thread, reader) != 0) {
+        pthread_cond_destroy(&os->cond[WAITER_WORKER]);
+        pthread_cond_destroy(&os->cond[WAITER_READER]);
+        pthread_mutex_destroy(&os->mutex);
+        free(os);
+        reader->os = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+static void reader_os_delete(lv_video_reader_t * reader)
+{
+    reader_os_t * os = reader->os;
+
+    pthread_join(os->thread, NULL);
+    pthread_cond_destroy(&os->cond[WAITER_WORKER]);
+    pthread_cond_destroy(&os->cond[WAITER_READER]);
+    pthread_mutex_destroy(&os->mutex);
+    free(os);
+    reader->os = NULL;
+}
+
+static void reader_lock(lv_video_reader_t * reader)
+{
+    pthread_mutex_lock(&((reader_os_t *)reader->os)->mutex);
+}
+
+static void reader_unlock(lv_video_reader_t * reader)
+{
+    pthread_mutex_unlock(&((reader_os_t *)reader->os)->mutex);
+}
+
+/**
+ * Wait until woken up. Call it locked, it's locked again when it returns.
+ */
+static void reader_wait(lv_video_reader_t * reader, int waiter)
+{
+    reader_os_t * os = reader->os;
+    pthread_cond_wait(&os->cond[waiter], &os->mutex);
+}
+
+/**
+ * Wake up the worker or the reader. Call it unlocked after changing the state.
+ */
+static void reader_wake(lv_video_reader_t * reader, int waiter)
+{
+    reader_os_t * os = reader->os;
+    pthread_mutex_lock(&os->mutex);
+    pthread_cond_signal(&os->cond[waiter]);
+    pthread_mutex_unlock(&os->mutex);
+}
+
+#else
+
+static void reader_task(void * param)
+{
+    lv_video_reader_t * reader = param;
+    reader_os_t * os = reader->os;
+
+    reader_work(reader);
+
+    os->running = false;
+    vTaskDelete(NULL);
+}
+
+static bool reader_os_create(lv_video_reader_t * reader)
+{
+    reader_os_t * os = malloc(sizeof(reader_os_t));
+    if(os == NULL) return false;
+
+    os->sem[WAITER_WORKER] = xSemaphoreCreateBinary();
+    os->sem[WAITER_READER] = xSemaphoreCreateBinary();
+    os->running = true;
+    reader->os = os;
+
+    if(os->sem[WAITER_WORKER] == NULL || os->sem[WAITER_READER] == NULL ||
+       xTaskCreate(reader_task, "video_rd", LV_VIDEO_READER_TASK_STACK_SIZE / sizeof(StackType_t), reader,
+                   LV_VIDEO_READER_TASK_PRIORITY, NULL) != pdPASS) {
+        if(os->sem[WAITER_WORKER]) vSemaphoreDelete(os->sem[WAITER_WORKER]);
+        if(os->sem[WAITER_READER]) vSemaphoreDelete(os->sem[WAITER_READER]);
+        free(os);
+        reader->os = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+static void reader_os_delete(lv_video_reader_t * reader)
+{
+    reader_os_t * os = reader->os;
+
+    while(os->running) {
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    vSemaphoreDelete(os->sem[WAITER_WORKER]);
+    vSemaphoreDelete(os->sem[WAITER_READER]);
+    free(os);
+    reader->os = NULL;
+}
+
+static void reader_lock(lv_video_reader_t * reader)
+{
+    LV_UNUSED(reader);
+    taskENTER_CRITICAL();
+}
+
+static void reader_unlock(lv_video_reader_t * reader)
+{
+    LV_UNUSED(reader);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * Wait until woken up. Call it locked, it's locked again when it returns.
+ * A wake up given before the wait is kept by the semaphore, so it's not missed.
+ */
+static void reader_wait(lv_video_reader_t * reader, int waiter)
+{
+    reader_os_t * os = reader->os;
+    taskEXIT_CRITICAL();
+    xSemaphoreTake(os->sem[waiter], portMAX_DELAY);
+    taskENTER_CRITICAL();
+}
+
+/**
+ * Wake up the worker or the reader. Call it unlocked after changing the state.
+ */
+static void reader_wake(lv_video_reader_t * reader, int waiter)
+{
+    reader_os_t * os = reader->os;
+    xSemaphoreGive(os->sem[waiter]);
+}
+
+#endif /*LV_USE_GUIDER_SIMULATOR*/
+
+#endif /*LV_VIDEO_READ_AHEAD_CNT*/
+
+#endif /*LV_USE_VIDEO*/
@@ -0,0 +1,104 @@
+/**
+ * @file lv_video_reader.h
+ * Read-ahead of a file in a background thread: the next blocks are read while the current one is decoded.
+ */
+
+#ifndef LV_VIDEO_READER_H
+#define LV_VIDEO_READER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#include "../../../misc/lv_types.h"
+#include "../../../misc/lv_fs.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#if LV_USE_VIDEO != 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A block of the file read ahead
+ */
+typedef struct {
+    uint8_t * data;     /**< `LV_VIDEO_READ_AHEAD_SIZE` bytes*/
+    uint32_t pos;       /**< File offset of `data[0]`*/
+    uint32_t len;       /**< Number of the bytes read into `data`*/
+} lv_video_reader_buf_t;
+
+typedef struct {
+    lv_fs_file_t * file;
+#if LV_VIDEO_READ_AHEAD_CNT > 0
+    /*The worker fills the buffers after `rd` in a ring, the reader empties them from `rd`*/
+    lv_video_reader_buf_t bufs[LV_VIDEO_READ_AHEAD_CNT];
+    uint8_t rd;                 /**< The buffer read by `lv_video_reader_read()`*/
+    uint8_t filled;             /**< Number of the filled buffers from `rd`*/
+    uint32_t rd_ofs;            /**< Bytes of `bufs[rd]` already read*/
+    uint32_t next_pos;          /**< File offset of the next block of the worker*/
+    uint32_t gen;               /**< Incremented by seeking, the worker drops a block read before it*/
+    lv_fs_res_t res;            /**< Read error of the worker, it stops until the next seek*/
+    bool eof;                   /**< The worker read until the end of the file*/
+    bool stop;
+    void * os;                  /**< Thread and synchronization objects*/
+#endif
+} lv_video_reader_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start reading a file ahead from a position
+ * @param reader pointer to a reader
+ * @param file pointer to an opened file. Only the worker uses it until `lv_video_reader_close()`.
+ * @param pos file offset to start from
+ * @return LV_RES_OK: started; LV_RES_INV: out of memory or the thread can't be created
+ */
+lv_res_t lv_video_reader_open(lv_video_reader_t * reader, lv_fs_file_t * file, uint32_t pos);
+
+/**
+ * Stop the worker and free the buffers. The file is not closed.
+ * @param reader pointer to an opened reader
+ */
+void lv_video_reader_close(lv_video_reader_t * reader);
+
+/**
+ * Read the file from the current position. It blocks until the data is read ahead.
+ * @param reader pointer to an opened reader
+ * @param buf store the data here
+ * @param btr bytes to read
+ * @param br store the number of the read bytes here, less than `btr` only at the end of the file
+ * @return LV_FS_RES_OK or the error of the file system driver
+ */
+lv_fs_res_t lv_video_reader_read(lv_video_reader_t * reader, void * buf, uint32_t btr, uint32_t * br);
+
+/**
+ * Continue reading from a position. The blocks read ahead are kept if the position is in them.
+ * @param reader pointer to an opened reader
+ * @param pos file offset
+ */
+void lv_video_reader_seek(lv_video_reader_t * reader, uint32_t pos);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_VIDEO*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VIDEO_READER_H*/
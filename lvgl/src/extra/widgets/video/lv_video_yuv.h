@@ -0,0 +1,77 @@
+/**
+ * @file lv_video_yuv.h
+ * Conversion of the decoded YUV 4:2:0 frames to the color formats of LVGL with nearest neighbour scaling.
+ */
+
+#ifndef LV_VIDEO_YUV_H
+#define LV_VIDEO_YUV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+
+#if LV_USE_VIDEO != 0
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Size of the line buffer of `lv_video_yuv_convert` for a destination width*/
+#define LV_VIDEO_YUV_LINE_BUF_SIZE(dst_w)   (3 * (dst_w))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum {
+    LV_VIDEO_YUV_OUT_RGB565,      /**< `lv_color_t` of LV_COLOR_DEPTH 16, swapped with LV_COLOR_16_SWAP*/
+    LV_VIDEO_YUV_OUT_ARGB8888,    /**< `lv_color_t` of LV_COLOR_DEPTH 32, opaque*/
+    LV_VIDEO_YUV_OUT_RGB565A8,    /**< RGB565 pixels followed by an opaque alpha plane*/
+};
+typedef uint8_t lv_video_yuv_out_t;
+
+/**
+ * The planes of a YUV 4:2:0 frame as returned by the decoder
+ */
+typedef struct {
+    const uint8_t * y;
+    const uint8_t * u;
+    const uint8_t * v;
+    int32_t y_stride;       /**< Bytes between two rows of `y`*/
+    int32_t uv_stride;      /**< Bytes between two rows of `u` and `v`*/
+    int32_t w;
+    int32_t h;
+} lv_video_yuv_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Convert a frame and scale it to the destination size. The planes are read in place.
+ * The pixels are the same on every platform, vector instructions are used where the compiler supports them.
+ * @param src       the decoded frame
+ * @param dst       buffer of `dst_w * dst_h` pixels of the output format
+ * @param dst_w     width of the destination
+ * @param dst_h     height of the destination
+ * @param out       output format
+ * @param line_buf  scratch buffer of `LV_VIDEO_YUV_LINE_BUF_SIZE(dst_w)` bytes
+ */
+void lv_video_yuv_convert(const lv_video_yuv_t * src, void * dst, int32_t dst_w, int32_t dst_h,
+                          lv_video_yuv_out_t out, uint8_t * line_buf);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_VIDEO*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VIDEO_YUV_H*/
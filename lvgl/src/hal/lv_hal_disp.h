@@ -32,6 +32,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_INV_AREA_OVERHEAD
+#define LV_INV_AREA_OVERHEAD 4096 /*Cost of drawing an invalid area separately in pixels. Used to join the areas*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -0,0 +1,301 @@
+/**
+ * @file lv_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+
+#if LV_USE_PROFILER
+
+#include "../../lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TID_MAX     32  /*Nesting is tracked for this many threads while dumping*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const lv_obj_class_t * class_p;
+    const char * name;
+} class_name_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static const char * get_class_name(const void * class_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_profiler_event_t events[LV_PROFILER_BUF_SIZE];
+static uint32_t event_wr;       /*Index of the next event to write*/
+static bool event_wrapped;      /*The ring buffer was filled at least once*/
+static bool enabled;
+static lv_profiler_tick_get_cb_t tick_get_cb;
+static uint32_t tick_per_sec = 1000;
+static lv_profiler_tid_get_cb_t tid_get_cb;
+
+#define CLASS_NAME(name) {&name##_class, #name}
+static const class_name_t class_names[] = {
+    CLASS_NAME(lv_obj),
+#if LV_USE_ARC
+    CLASS_NAME(lv_arc),
+#endif
+#if LV_USE_BAR
+    CLASS_NAME(lv_bar),
+#endif
+#if LV_USE_BTN
+    CLASS_NAME(lv_btn),
+#endif
+#if LV_USE_BTNMATRIX
+    CLASS_NAME(lv_btnmatrix),
+#endif
+#if LV_USE_CANVAS
+    CLASS_NAME(lv_canvas),
+#endif
+#if LV_USE_CHECKBOX
+    CLASS_NAME(lv_checkbox),
+#endif
+#if LV_USE_DROPDOWN
+    CLASS_NAME(lv_dropdown),
+    CLASS_NAME(lv_dropdownlist),
+#endif
+#if LV_USE_IMG
+    CLASS_NAME(lv_img),
+#endif
+#if LV_USE_LABEL
+    CLASS_NAME(lv_label),
+#endif
+#if LV_USE_LINE
+    CLASS_NAME(lv_line),
+#endif
+#if LV_USE_ROLLER
+    CLASS_NAME(lv_roller),
+#endif
+#if LV_USE_SLIDER
+    CLASS_NAME(lv_slider),
+#endif
+#if LV_USE_SWITCH
+    CLASS_NAME(lv_switch),
+#endif
+#if LV_USE_TABLE
+    CLASS_NAME(lv_table),
+#endif
+#if LV_USE_TEXTAREA
+    CLASS_NAME(lv_textarea),
+#endif
+#if LV_USE_ANALOGCLOCK
+    CLASS_NAME(lv_analogclock),
+#endif
+#if LV_USE_ANIMIMG
+    CLASS_NAME(lv_animimg),
+#endif
+#if LV_USE_CALENDAR
+    CLASS_NAME(lv_calendar),
+#endif
+#if LV_USE_CAROUSEL
+    CLASS_NAME(lv_carousel),
+    CLASS_NAME(lv_carousel_element),
+#endif
+#if LV_USE_CHART
+    CLASS_NAME(lv_chart),
+#endif
+#if LV_USE_COLORWHEEL
+    CLASS_NAME(lv_colorwheel),
+#endif
+#if LV_USE_DCLOCK
+    CLASS_NAME(lv_dclock),
+#endif
+#if LV_USE_IMGBTN
+    CLASS_NAME(lv_imgbtn),
+#endif
+#if LV_USE_KEYBOARD
+    CLASS_NAME(lv_keyboard),
+#endif
+#if LV_USE_LED
+    CLASS_NAME(lv_led),
+#endif
+#if LV_USE_LIST
+    CLASS_NAME(lv_list),
+    CLASS_NAME(lv_list_btn),
+    CLASS_NAME(lv_list_text),
+#endif
+#if LV_USE_METER
+    CLASS_NAME(lv_meter),
+#endif
+#if LV_USE_MSGBOX
+    CLASS_NAME(lv_msgbox),
+#endif
+#if LV_USE_RADIOBTN
+    CLASS_NAME(lv_radiobtn),
+    CLASS_NAME(lv_radiobtn_item),
+#endif
+#if LV_USE_SPAN
+    CLASS_NAME(lv_spangroup),
+#endif
+#if LV_USE_SPINBOX
+    CLASS_NAME(lv_spinbox),
+#endif
+#if LV_USE_SPINNER
+    CLASS_NAME(lv_spinner),
+#endif
+#if LV_USE_TABVIEW
+    CLASS_NAME(lv_tabview),
+#endif
+#if LV_USE_TEXTPROGRESS
+    CLASS_NAME(lv_textprogress),
+#endif
+#if LV_USE_TILEVIEW
+    CLASS_NAME(lv_tileview),
+    CLASS_NAME(lv_tileview_tile),
+#endif
+#if LV_USE_VIDEO
+    CLASS_NAME(lv_video),
+#endif
+#if LV_USE_WIN
+    CLASS_NAME(lv_win),
+#endif
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_profiler_enable(bool en)
+{
+    enabled = en;
+}
+
+bool lv_profiler_is_enabled(void)
+{
+    return enabled;
+}
+
+void lv_profiler_set_tick_cb(lv_profiler_tick_get_cb_t cb, uint32_t per_sec)
+{
+    tick_get_cb = cb;
+    tick_per_sec = cb ? per_sec : 1000;
+    lv_profiler_reset();
+}
+
+void lv_profiler_set_tid_cb(lv_profiler_tid_get_cb_t cb)
+{
+    tid_get_cb = cb;
+}
+
+void lv_profiler_reset(void)
+{
+    _lv_refr_parallel_lock();
+    event_wr = 0;
+    event_wrapped = false;
+    _lv_refr_parallel_unlock();
+}
+
+void _lv_profiler_record(const char * tag, const void * obj, const void * class_p, lv_profiler_event_type_t type)
+{
+    if(!enabled) return;
+
+    uint32_t tick = tick_get_cb ? tick_get_cb() : lv_tick_get();
+    uint16_t tid = tid_get_cb ? (uint16_t)tid_get_cb() : 0;
+
+    /*Render threads might record events in parallel*/
+    _lv_refr_parallel_lock();
+    lv_profiler_event_t * e = &events[event_wr];
+    e->tag = tag;
+    e->obj = obj;
+    e->class_p = class_p;
+    e->tick = tick;
+    e->tid = tid;
+    e->type = type;
+
+    event_wr++;
+    if(event_wr >= LV_PROFILER_BUF_SIZE) {
+        event_wr = 0;
+        event_wrapped = true;
+    }
+    _lv_refr_parallel_unlock();
+}
+
+void lv_profiler_dump(lv_profiler_write_cb_t write_cb, void * user_data)
+{
+    /*Don't record the events of the dump itself*/
+    bool en_ori = enabled;
+    enabled = false;
+
+    uint32_t start = event_wrapped ? event_wr : 0;
+    uint32_t cnt = event_wrapped ? LV_PROFILER_BUF_SIZE : event_wr;
+    uint32_t tick_start = cnt ? events[start].tick : 0;
+    uint16_t depth[TID_MAX];
+    lv_memset_00(depth, sizeof(depth));
+
+    write_cb("{\"traceEvents\":[", user_data);
+
+    bool first = true;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        const lv_profiler_event_t * e = &events[(start + i) % LV_PROFILER_BUF_SIZE];
+
+        /*The beginning might be overwritten already in the ring buffer*/
+        uint16_t * d = &depth[e->tid % TID_MAX];
+        if(e->type == LV_PROFILER_EVENT_END) {
+            if(*d == 0) continue;
+            (*d)--;
+        }
+        else {
+            (*d)++;
+        }
+
+        uint64_t us = ((uint64_t)(uint32_t)(e->tick - tick_start) * 1000000) / tick_per_sec;
+        char buf[192];
+        if(e->obj) {
+            lv_snprintf(buf, sizeof(buf),
+                        "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u,"
+                        "\"args\":{\"obj\":\"%p\"}}",
+                        first ? "" : ",", get_class_name(e->class_p), e->tag,
+                        e->type == LV_PROFILER_EVENT_BEGIN ? 'B' : 'E', (unsigned long)us, e->tid, e->obj);
+        }
+        else {
+            lv_snprintf(buf, sizeof(buf),
+                        "%s\n{\"name\":\"%s\",\"cat\":\"lvgl\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u}",
+                        first ? "" : ",", e->tag,
+                        e->type == LV_PROFILER_EVENT_BEGIN ? 'B' : 'E', (unsigned long)us, e->tid);
+        }
+        write_cb(buf, user_data);
+        first = false;
+    }
+
+    write_cb("\n]}\n", user_data);
+
+    enabled = en_ori;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static const char * get_class_name(const void * class_p)
+{
+    /*Use the name of the first known base class for custom widgets*/
+    const lv_obj_class_t * c = class_p;
+    while(c) {
+        uint32_t i;
+        for(i = 0; i < sizeof(class_names) / sizeof(class_names[0]); i++) {
+            if(class_names[i].class_p == c) return class_names[i].name;
+        }
+        c = c->base_class;
+    }
+
+    return "unknown";
+}
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,125 @@
+/**
+ * @file lv_profiler.h
+ *
+ */
+
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#if LV_USE_PROFILER
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum {
+    LV_PROFILER_EVENT_BEGIN,
+    LV_PROFILER_EVENT_END,
+};
+typedef uint8_t lv_profiler_event_type_t;
+
+/**
+ * An entry of the profiler's ring buffer
+ */
+typedef struct {
+    const char * tag;               /**< Name of the measured phase, a string constant*/
+    const void * obj;               /**< The object the phase belongs to or NULL*/
+    const void * class_p;           /**< Class of `obj` when the event was recorded*/
+    uint32_t tick;                  /**< Time stamp from the tick callback*/
+    uint16_t tid;                   /**< Id of the recording thread*/
+    lv_profiler_event_type_t type;  /**< `LV_PROFILER_EVENT_BEGIN` or `LV_PROFILER_EVENT_END`*/
+} lv_profiler_event_t;
+
+typedef uint32_t (*lv_profiler_tick_get_cb_t)(void);
+typedef uint32_t (*lv_profiler_tid_get_cb_t)(void);
+typedef void (*lv_profiler_write_cb_t)(const char * str, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start or stop recording the profiler events. It's stopped by default.
+ * @param en    true: start recording; false: stop recording
+ */
+void lv_profiler_enable(bool en);
+
+/**
+ * Tell if the profiler events are recorded
+ * @return true: the events are recorded
+ */
+bool lv_profiler_is_enabled(void);
+
+/**
+ * Set the time source of the profiler. `lv_tick_get()` is used by default which has only 1 ms resolution.
+ * @param tick_get_cb   a function returning a free running counter
+ * @param tick_per_sec  increments of the counter in a second, e.g. 1000000 for microseconds
+ */
+void lv_profiler_set_tick_cb(lv_profiler_tick_get_cb_t tick_get_cb, uint32_t tick_per_sec);
+
+/**
+ * Set a function to identify the thread which records an event. Required only with parallel rendering.
+ * @param tid_get_cb    a function returning a small number unique to the calling thread
+ */
+void lv_profiler_set_tid_cb(lv_profiler_tid_get_cb_t tid_get_cb);
+
+/**
+ * Drop the recorded events
+ */
+void lv_profiler_reset(void);
+
+/**
+ * Write the recorded events in Chrome trace JSON format (loadable in `chrome://tracing` or Perfetto).
+ * The oldest events might be overwritten already, the end events without a beginning are skipped.
+ * @param write_cb      called with the consecutive pieces of the JSON text
+ * @param user_data     passed to `write_cb`
+ */
+void lv_profiler_dump(lv_profiler_write_cb_t write_cb, void * user_data);
+
+/**
+ * Record an event. Use the `LV_PROFILER_...` macros instead.
+ * @param tag       name of the phase
+ * @param obj       the object the phase belongs to or NULL
+ * @param class_p   class of `obj` or NULL
+ * @param type      `LV_PROFILER_EVENT_BEGIN` or `LV_PROFILER_EVENT_END`
+ */
+void _lv_profiler_record(const char * tag, const void * obj, const void * class_p, lv_profiler_event_type_t type);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_PROFILER_BEGIN_TAG(tag)      _lv_profiler_record(tag, NULL, NULL, LV_PROFILER_EVENT_BEGIN)
+#define LV_PROFILER_END_TAG(tag)        _lv_profiler_record(tag, NULL, NULL, LV_PROFILER_EVENT_END)
+#define LV_PROFILER_BEGIN_OBJ(tag, obj) _lv_profiler_record(tag, obj, (obj)->class_p, LV_PROFILER_EVENT_BEGIN)
+#define LV_PROFILER_END_OBJ(tag, obj)   _lv_profiler_record(tag, obj, (obj)->class_p, LV_PROFILER_EVENT_END)
+
+#else
+
+#define LV_PROFILER_BEGIN_TAG(tag)
+#define LV_PROFILER_END_TAG(tag)
+#define LV_PROFILER_BEGIN_OBJ(tag, obj)
+#define LV_PROFILER_END_OBJ(tag, obj)
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PROFILER_H*/
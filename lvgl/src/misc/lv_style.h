@@ -76,6 +76,10 @@ LV_EXPORT_CONST_INT(LV_IMG_ZOOM_NONE);
 
 #define LV_STYLE_PROP_ID_MASK(prop) ((lv_style_prop_t)((prop) & ~LV_STYLE_PROP_META_MASK))
 
+/*The properties of the non-constant styles are sorted by ID.
+ *Up to this number of properties they are scanned linearly, above it they are binary searched.*/
+#define _LV_STYLE_LINEAR_MAX_CNT    8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -323,7 +327,7 @@ typedef struct {
 #endif
 
     /*If there is only one property store it directly.
-     *For more properties allocate an array*/
+     *For more properties allocate an array of the values followed by the property IDs sorted by ID*/
     union {
         lv_style_value_t value1;
         uint8_t * values_and_props;
@@ -436,6 +440,33 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Find the place of a property in the sorted property IDs of a non-constant style
+ * @param props the property IDs, possibly with meta flags, sorted by ID
+ * @param cnt   number of the properties
+ * @param prop  the ID of a property
+ * @return      index of the first property whose ID is not less than `prop`, `cnt` if there is none
+ */
+static inline uint32_t _lv_style_prop_lower_bound(const uint16_t * props, uint32_t cnt, lv_style_prop_t prop)
+{
+    uint32_t i;
+    if(cnt <= _LV_STYLE_LINEAR_MAX_CNT) {
+        for(i = 0; i < cnt; i++) {
+            if(LV_STYLE_PROP_ID_MASK(props[i]) >= prop) break;
+        }
+        return i;
+    }
+
+    /*Without branches on the comparison, they would be mispredicted in every step*/
+    i = 0;
+    while(cnt > 1) {
+        uint32_t half = cnt / 2;
+        i = LV_STYLE_PROP_ID_MASK(props[i + half - 1]) < prop ? i + half : i;
+        cnt -= half;
+    }
+    return i + (LV_STYLE_PROP_ID_MASK(props[i]) < prop);
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -471,19 +502,36 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
         uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
         uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
-            if(prop_id == prop) {
-                if(props[i] & LV_STYLE_PROP_META_INHERIT)
-                    return LV_STYLE_RES_INHERIT;
-                if(props[i] & LV_STYLE_PROP_META_INITIAL)
-                    *value = lv_style_prop_get_default(prop_id);
-                else {
-                    lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                    *value = values[i];
+        if(style->prop_cnt <= _LV_STYLE_LINEAR_MAX_CNT) {
+            /*Small styles are the most common, the plain scan is the fastest for them*/
+            for(i = 0; i < style->prop_cnt; i++) {
+                lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(props[i]);
+                if(prop_id == prop) {
+                    if(props[i] & LV_STYLE_PROP_META_INHERIT)
+                        return LV_STYLE_RES_INHERIT;
+                    if(props[i] & LV_STYLE_PROP_META_INITIAL)
+                        *value = lv_style_prop_get_default(prop_id);
+                    else {
+                        lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+                        *value = values[i];
+                    }
+                    return LV_STYLE_RES_FOUND;
                 }
-                return LV_STYLE_RES_FOUND;
             }
+            return LV_STYLE_RES_NOT_FOUND;
+        }
+
+        i = _lv_style_prop_lower_bound(props, style->prop_cnt, prop);
+        if(i < style->prop_cnt && LV_STYLE_PROP_ID_MASK(props[i]) == prop) {
+            if(props[i] & LV_STYLE_PROP_META_INHERIT)
+                return LV_STYLE_RES_INHERIT;
+            if(props[i] & LV_STYLE_PROP_META_INITIAL)
+                *value = lv_style_prop_get_default(prop);
+            else {
+                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+                *value = values[i];
+            }
+            return LV_STYLE_RES_FOUND;
         }
     }
     else if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
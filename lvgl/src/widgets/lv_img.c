@@ -598,14 +598,15 @@ static void draw_img(lv_event_t * e)
             bg_coords.y2 += obj->coords.y1;
         }
 
-        lv_area_t ori_coords;
-        lv_area_copy(&ori_coords, &obj->coords);
-        lv_area_copy(&obj->coords, &bg_coords);
-
-        lv_res_t res = lv_obj_event_base(MY_CLASS, e);
-        if(res != LV_RES_OK) return;
-
-        lv_area_copy(&obj->coords, &ori_coords);
+        /*The other threads of the parallel rendering read the coordinates too so they can't be changed
+         *to draw the background on the transformed area. Pass the area to the base class' drawing instead.*/
+        if(_lv_area_is_equal(&obj->coords, &bg_coords)) {
+            lv_res_t res = lv_obj_event_base(MY_CLASS, e);
+            if(res != LV_RES_OK) return;
+        }
+        else {
+            lv_obj_draw_main_on(obj, e, &bg_coords);
+        }
 
         if(code == LV_EVENT_DRAW_MAIN) {
             if(img->h == 0 || img->w == 0) return;
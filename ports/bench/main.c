@@ -0,0 +1,895 @@
+/*
+ * SPDX-License-Identifier: MIT
+ * Copyright 2024 NXP
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#define _DEFAULT_SOURCE /* needed for clock_gettime() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+#include "gui_guider.h"
+#include "events_init.h"
+#include "custom.h"
+#if LV_USE_VIDEO
+#include "extra/widgets/video/lv_video_yuv.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_TICK_CUSTOM
+#error "The benchmark advances the tick itself, set LV_TICK_CUSTOM to 0"
+#endif
+
+/* Virtual time between two frames. Every step refreshes the invalidated areas. */
+#define BENCH_FRAME_PERIOD  LV_DISP_DEF_REFR_PERIOD
+
+#define BENCH_FRAME_MAX     512     /* Max. recorded frames of a scenario */
+#define BENCH_LOAD_CNT      10      /* Screen loads of the "load" scenario */
+#define BENCH_REDRAW_CNT    60      /* Full screen redraws of the "redraw" scenario */
+#define BENCH_ANIM_TIME     2000    /* Duration of the "anim" scenario in ms */
+#define BENCH_ANIM_DIST     40      /* Distance of the move animations in px */
+#define BENCH_DRAG_STEPS    30      /* Frames of dragging a slider in one direction */
+#define BENCH_YUV_CNT       30      /* Converted frames per source size of "video_yuv" */
+#define BENCH_LABEL_CNT     48      /* Small labels updated in every frame of the "labels" scenario */
+#define BENCH_LABEL_FRAMES  30      /* Frames of the "labels" scenario */
+#define BENCH_CARD_CNT      16      /* Overlapping opaque cards of the "cards" scenario */
+#define BENCH_CARD_FRAMES   30      /* Full screen redraws of the "cards" scenario */
+#define BENCH_CACHE_GRAD_CNT 8      /* Gradient rectangles of the "caches" scenario */
+#define BENCH_CACHE_LINES   96      /* Lines of the label of "caches", taller than the limit of the label hint */
+#define BENCH_CACHE_FRAMES  30      /* Full screen redraws of the "caches" scenario */
+#define BENCH_PARALLEL_JOBS 4       /* Bands of "caches_parallel" */
+#define BENCH_STYLE_ROUNDS  20000   /* Lookups of every built-in property per style of "style_lookup" */
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const char * name;
+    ui_setup_scr_t setup_scr;
+} bench_screen_t;
+
+typedef enum {
+    BENCH_DRAW_RECT,
+    BENCH_DRAW_BG,
+    BENCH_DRAW_ARC,
+    BENCH_DRAW_IMG,
+    BENCH_DRAW_LETTER,
+    BENCH_DRAW_LINE,
+    BENCH_DRAW_POLYGON,
+    BENCH_DRAW_LAYER,
+    _BENCH_DRAW_LAST
+} bench_draw_t;
+
+typedef struct {
+    uint32_t frame_us[BENCH_FRAME_MAX];
+    uint32_t frame_cnt;
+    uint32_t draw_cnt[_BENCH_DRAW_LAST];
+    uint64_t px_cnt;
+    uint32_t setup_cnt;     /* Calls of `setup_scr` measured below */
+    uint64_t setup_us;      /* Sum of the duration of `setup_scr` */
+    uint32_t setup_heap;    /* Heap used by the last created screen */
+} bench_stat_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void hal_init(void);
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
+static void indev_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
+static void draw_counter_init(lv_draw_ctx_t * draw_ctx);
+static void count_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void count_draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void count_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                           uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static void count_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                   const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format);
+static void count_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                              uint32_t letter);
+static void count_draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                            const lv_point_t * point2);
+static void count_draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                               const lv_point_t * points, uint16_t point_cnt);
+static void count_layer_blend(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                              const lv_draw_img_dsc_t * dsc);
+static uint32_t time_us(void);
+static bool run_frame(void);
+static void run_load(const bench_screen_t * screen);
+static void run_redraw(void);
+static void run_anim(void);
+static void run_slider_drag(void);
+static void slider_drag(lv_obj_t * obj);
+static void run_labels(void);
+static void run_cards(void);
+static void run_caches(bool parallel);
+#if LV_USE_PARALLEL_REFR
+/**
+ * Run the jobs of the parallel rendering one after another
+ */
+static void parallel_run_serial(lv_refr_parallel_job_cb_t job_cb, void * user_data, uint32_t job_cnt);
+#endif
+static void stat_reset(void);
+static void report_begin(void);
+static void report_screen(const bench_screen_t * screen, bool first);
+static void report_scenario(const char * name, bool first);
+static void report_end(void);
+static void report_style_lookup(void);
+static lv_style_res_t style_get_prop_linear(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value);
+#if LV_USE_VIDEO
+static void report_video_yuv(void);
+#endif
+static int cmp_u32(const void * a, const void * b);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+/* The screens to measure. List the generated `setup_scr_...` functions of the project here. */
+static const bench_screen_t bench_screens[] = {
+    {"screen", setup_scr_screen},
+};
+
+static const char * draw_names[_BENCH_DRAW_LAST] = {
+    "rect", "bg", "arc", "img", "letter", "line", "polygon", "layer"
+};
+
+static lv_color_t frame_buf[LV_HOR_RES_MAX * LV_VER_RES_MAX];
+static lv_disp_t * disp;
+static lv_point_t indev_point;
+static lv_indev_state_t indev_state = LV_INDEV_STATE_RELEASED;
+static bool frame_rendered;
+static bench_stat_t stat;
+static FILE * out;
+static uint32_t setup_ui_us;
+
+/* The callbacks of the draw context wrapped by the draw call counters */
+static lv_draw_ctx_t draw_ori;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+lv_ui guider_ui;
+
+/**
+ * Render the generated screens on an in-memory display and print the statistics as JSON.
+ * Usage: gui_guider_bench [output.json]
+ */
+int main(int argc, char ** argv)
+{
+    out = stdout;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == NULL) {
+            fprintf(stderr, "can't open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    /*Initialize LittlevGL*/
+    lv_init();
+
+    /*Initialize the in-memory display and the virtual input device*/
+    hal_init();
+
+    /*Create a GUI-Guider app */
+    uint32_t t = time_us();
+    setup_ui(&guider_ui);
+    custom_init(&guider_ui);
+    setup_ui_us = time_us() - t;
+    run_frame();
+
+    report_begin();
+    uint32_t i;
+    for (i = 0; i < sizeof(bench_screens) / sizeof(bench_screens[0]); i++) {
+        const bench_screen_t * screen = &bench_screens[i];
+        report_screen(screen, i == 0);
+
+        run_load(screen);
+        report_scenario("load", true);
+
+        run_redraw();
+        report_scenario("redraw", false);
+
+        run_anim();
+        report_scenario("anim", false);
+
+        run_slider_drag();
+        report_scenario("slider_drag", false);
+
+        run_labels();
+        report_scenario("labels", false);
+
+        run_cards();
+        report_scenario("cards", false);
+
+        run_caches(false);
+        report_scenario("caches", false);
+
+#if LV_USE_PARALLEL_REFR
+        /* The same with the parallel rendering. The difference to "caches" is the cost of rendering every band
+         * separately and of the gradient cache, the glyph cache and the label hint, which are bypassed then. */
+        run_caches(true);
+        report_scenario("caches_parallel", false);
+#endif
+
+        fprintf(out, "\n      ]\n    }");
+    }
+    report_end();
+
+    if (out != stdout) fclose(out);
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Register a display rendering into a full frame buffer and a pointer driven by the scenarios
+ */
+static void hal_init(void)
+{
+    static lv_disp_draw_buf_t draw_buf;
+    lv_disp_draw_buf_init(&draw_buf, frame_buf, NULL, LV_HOR_RES_MAX * LV_VER_RES_MAX);
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+    disp_drv.hor_res = LV_HOR_RES_MAX;
+    disp_drv.ver_res = LV_VER_RES_MAX;
+    disp = lv_disp_drv_register(&disp_drv);
+
+    draw_counter_init(disp_drv.draw_ctx);
+
+    static lv_indev_drv_t indev_drv;
+    lv_indev_drv_init(&indev_drv);
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    indev_drv.read_cb = indev_read_cb;
+    lv_indev_drv_register(&indev_drv);
+
+    /* Read the pointer in every frame */
+    lv_timer_set_period(indev_drv.read_timer, BENCH_FRAME_PERIOD);
+}
+
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(time);
+    frame_rendered = true;
+    stat.px_cnt += px;
+}
+
+static void indev_read_cb(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
+{
+    LV_UNUSED(indev_drv);
+    data->point = indev_point;
+    data->state = indev_state;
+}
+
+/**
+ * Count the draw calls by wrapping the callbacks of the draw context
+ */
+static void draw_counter_init(lv_draw_ctx_t * draw_ctx)
+{
+    draw_ori = *draw_ctx;
+    if (draw_ctx->draw_rect) draw_ctx->draw_rect = count_draw_rect;
+    if (draw_ctx->draw_bg) draw_ctx->draw_bg = count_draw_bg;
+    if (draw_ctx->draw_arc) draw_ctx->draw_arc = count_draw_arc;
+    if (draw_ctx->draw_img_decoded) draw_ctx->draw_img_decoded = count_draw_img_decoded;
+    if (draw_ctx->draw_letter) draw_ctx->draw_letter = count_draw_letter;
+    if (draw_ctx->draw_line) draw_ctx->draw_line = count_draw_line;
+    if (draw_ctx->draw_polygon) draw_ctx->draw_polygon = count_draw_polygon;
+    if (draw_ctx->layer_blend) draw_ctx->layer_blend = count_layer_blend;
+}
+
+static void count_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    stat.draw_cnt[BENCH_DRAW_RECT]++;
+    draw_ori.draw_rect(draw_ctx, dsc, coords);
+}
+
+static void count_draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    stat.draw_cnt[BENCH_DRAW_BG]++;
+    draw_ori.draw_bg(draw_ctx, dsc, coords);
+}
+
+static void count_draw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                           uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    stat.draw_cnt[BENCH_DRAW_ARC]++;
+    draw_ori.draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+}
+
+static void count_draw_img_decoded(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc,
+                                   const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    stat.draw_cnt[BENCH_DRAW_IMG]++;
+    draw_ori.draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format);
+}
+
+static void count_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                              uint32_t letter)
+{
+    stat.draw_cnt[BENCH_DRAW_LETTER]++;
+    draw_ori.draw_letter(draw_ctx, dsc, pos_p, letter);
+}
+
+static void count_draw_line(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                            const lv_point_t * point2)
+{
+    stat.draw_cnt[BENCH_DRAW_LINE]++;
+    draw_ori.draw_line(draw_ctx, dsc, point1, point2);
+}
+
+static void count_draw_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc,
+                               const lv_point_t * points, uint16_t point_cnt)
+{
+    stat.draw_cnt[BENCH_DRAW_POLYGON]++;
+    draw_ori.draw_polygon(draw_ctx, dsc, points, point_cnt);
+}
+
+static void count_layer_blend(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                              const lv_draw_img_dsc_t * dsc)
+{
+    stat.draw_cnt[BENCH_DRAW_LAYER]++;
+    draw_ori.layer_blend(draw_ctx, layer_ctx, dsc);
+}
+
+static uint32_t time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**
+ * Advance the virtual time by a frame period and run the timers.
+ * @return true if a frame was rendered; its time is recorded then
+ */
+static bool run_frame(void)
+{
+    lv_tick_inc(BENCH_FRAME_PERIOD);
+
+    frame_rendered = false;
+    uint32_t t = time_us();
+    lv_timer_handler();
+    t = time_us() - t;
+
+    if (frame_rendered && stat.frame_cnt < BENCH_FRAME_MAX) {
+        stat.frame_us[stat.frame_cnt] = t;
+        stat.frame_cnt++;
+    }
+
+    return frame_rendered;
+}
+
+/**
+ * Create the screen again and again. A frame is the creation, loading and first rendering of the screen.
+ */
+static void run_load(const bench_screen_t * screen)
+{
+    stat_reset();
+
+    uint32_t i;
+    for (i = 0; i < BENCH_LOAD_CNT; i++) {
+        lv_obj_t * old_scr = lv_scr_act();
+
+        lv_tick_inc(BENCH_FRAME_PERIOD);
+        frame_rendered = false;
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        uint32_t heap = mon.total_size - mon.free_size;
+        uint32_t t = time_us();
+        screen->setup_scr(&guider_ui);
+        uint32_t setup_us = time_us() - t;
+
+        /* The heap is measured out of the frame time */
+        lv_mem_monitor(&mon);
+        stat.setup_heap = (mon.total_size - mon.free_size) - heap;
+        stat.setup_us += setup_us;
+        stat.setup_cnt++;
+
+        t = time_us();
+        /* The generated function creates the screen as the last one of the display */
+        lv_scr_load(disp->screens[disp->screen_cnt - 1]);
+        lv_obj_del(old_scr);
+        lv_timer_handler();
+        t = setup_us + (time_us() - t);
+
+        if (stat.frame_cnt < BENCH_FRAME_MAX) {
+            stat.frame_us[stat.frame_cnt] = t;
+            stat.frame_cnt++;
+        }
+    }
+}
+
+/**
+ * Redraw the whole screen in every frame
+ */
+static void run_redraw(void)
+{
+    stat_reset();
+
+    uint32_t i;
+    for (i = 0; i < BENCH_REDRAW_CNT; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        run_frame();
+    }
+}
+
+/**
+ * Move all the widgets of the screen back and forth with the generated animation helper
+ */
+static void run_anim(void)
+{
+    stat_reset();
+
+    lv_obj_t * scr = lv_scr_act();
+    uint32_t child_cnt = lv_obj_get_child_cnt(scr);
+    uint32_t i;
+    for (i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(scr, i);
+        ui_move_animation(child, BENCH_ANIM_TIME / 4, 0,
+                          lv_obj_get_x(child) + BENCH_ANIM_DIST, lv_obj_get_y(child) + BENCH_ANIM_DIST,
+                          lv_anim_path_ease_in_out, LV_ANIM_REPEAT_INFINITE, 0, BENCH_ANIM_TIME / 4, 0,
+                          NULL, NULL, NULL);
+    }
+
+    uint32_t elaps;
+    for (elaps = 0; elaps < BENCH_ANIM_TIME; elaps += BENCH_FRAME_PERIOD) {
+        run_frame();
+    }
+
+    for (i = 0; i < child_cnt; i++) {
+        lv_anim_del(lv_obj_get_child(scr, i), NULL);
+    }
+    run_frame();
+}
+
+/**
+ * Drag all the sliders of the screen with the virtual pointer
+ */
+static void run_slider_drag(void)
+{
+    stat_reset();
+
+#if LV_USE_SLIDER
+    /* Walk the widget tree without recursion */
+    lv_obj_t * obj = lv_scr_act();
+    while (obj) {
+        if (lv_obj_check_type(obj, &lv_slider_class)) slider_drag(obj);
+
+        if (lv_obj_get_child_cnt(obj) > 0) {
+            obj = lv_obj_get_child(obj, 0);
+            continue;
+        }
+
+        /* Go to the next sibling or to the next sibling of a parent */
+        while (obj) {
+            lv_obj_t * parent = lv_obj_get_parent(obj);
+            if (parent == NULL) {
+                obj = NULL;
+                break;
+            }
+            uint32_t next = lv_obj_get_index(obj) + 1;
+            if (next < lv_obj_get_child_cnt(parent)) {
+                obj = lv_obj_get_child(parent, next);
+                break;
+            }
+            obj = parent;
+        }
+    }
+#endif
+}
+
+/**
+ * Press the slider, drag it to both ends and release it
+ */
+static void slider_drag(lv_obj_t * obj)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    bool hor = lv_area_get_width(&coords) >= lv_area_get_height(&coords);
+    lv_coord_t len = hor ? lv_area_get_width(&coords) : lv_area_get_height(&coords);
+
+    indev_point.x = (coords.x1 + coords.x2) / 2;
+    indev_point.y = (coords.y1 + coords.y2) / 2;
+    indev_state = LV_INDEV_STATE_PRESSED;
+    run_frame();
+
+    int32_t i;
+    for (i = 0; i <= 2 * BENCH_DRAG_STEPS; i++) {
+        /* From the middle to the beginning, to the end and back to the middle */
+        int32_t pos = i <= BENCH_DRAG_STEPS / 2 ? BENCH_DRAG_STEPS / 2 - i :
+                      i <= 3 * BENCH_DRAG_STEPS / 2 ? i - BENCH_DRAG_STEPS / 2 :
+                      5 * BENCH_DRAG_STEPS / 2 - i;
+        lv_coord_t ofs = (lv_coord_t)((len - 1) * pos / BENCH_DRAG_STEPS);
+        if (hor) indev_point.x = coords.x1 + ofs;
+        else indev_point.y = coords.y2 - ofs;
+        run_frame();
+    }
+
+    indev_state = LV_INDEV_STATE_RELEASED;
+    run_frame();
+}
+
+/**
+ * Update many small labels spread over the screen in every frame like a dashboard
+ */
+static void run_labels(void)
+{
+    stat_reset();
+
+#if LV_USE_LABEL
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_t * labels[BENCH_LABEL_CNT];
+    lv_coord_t col_cnt = 6;
+    lv_coord_t col_w = LV_HOR_RES_MAX / col_cnt;
+    lv_coord_t row_h = LV_VER_RES_MAX / ((BENCH_LABEL_CNT + col_cnt - 1) / col_cnt);
+    uint32_t i;
+    for (i = 0; i < BENCH_LABEL_CNT; i++) {
+        labels[i] = lv_label_create(scr);
+        lv_obj_set_pos(labels[i], (i % col_cnt) * col_w + 4, (i / col_cnt) * row_h + 4);
+    }
+    run_frame();
+    stat_reset();
+
+    uint32_t f;
+    for (f = 0; f < BENCH_LABEL_FRAMES; f++) {
+        for (i = 0; i < BENCH_LABEL_CNT; i++) {
+            lv_label_set_text_fmt(labels[i], "%u", (unsigned)((f * 7 + i * 13) % 1000));
+        }
+        run_frame();
+    }
+
+    for (i = 0; i < BENCH_LABEL_CNT; i++) {
+        lv_obj_del(labels[i]);
+    }
+    run_frame();
+#endif
+}
+
+/**
+ * Redraw a cascade of opaque cards covering each other like stacked windows.
+ * Only the top card is fully visible, the others only by a strip.
+ */
+static void run_cards(void)
+{
+    stat_reset();
+
+#if LV_USE_LABEL
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_t * cards[BENCH_CARD_CNT];
+    lv_coord_t card_w = LV_HOR_RES_MAX * 2 / 3;
+    lv_coord_t card_h = LV_VER_RES_MAX / 2;
+    lv_coord_t step_x = (LV_HOR_RES_MAX - card_w) / BENCH_CARD_CNT;
+    lv_coord_t step_y = (LV_VER_RES_MAX - card_h) / BENCH_CARD_CNT;
+    uint32_t i;
+    for (i = 0; i < BENCH_CARD_CNT; i++) {
+        cards[i] = lv_obj_create(scr);
+        lv_obj_set_pos(cards[i], i * step_x, i * step_y);
+        lv_obj_set_size(cards[i], card_w, card_h);
+        lv_obj_clear_flag(cards[i], LV_OBJ_FLAG_SCROLLABLE);
+
+        uint32_t j;
+        for (j = 0; j < 4; j++) {
+            lv_obj_t * label = lv_label_create(cards[i]);
+            lv_label_set_text_fmt(label, "Card %u, line %u", (unsigned)i, (unsigned)j);
+            lv_obj_set_y(label, j * card_h / 4);
+        }
+    }
+    run_frame();
+    stat_reset();
+
+    uint32_t f;
+    for (f = 0; f < BENCH_CARD_FRAMES; f++) {
+        lv_obj_invalidate(scr);
+        run_frame();
+    }
+
+    for (i = 0; i < BENCH_CARD_CNT; i++) {
+        lv_obj_del(cards[i]);
+    }
+    run_frame();
+#endif
+}
+
+/**
+ * Redraw gradients and a tall label which use the caches bypassed by the parallel rendering
+ * @param parallel  true: render the bands as the jobs of the parallel rendering
+ */
+static void run_caches(bool parallel)
+{
+    stat_reset();
+
+#if LV_USE_LABEL
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_t * rects[BENCH_CACHE_GRAD_CNT];
+    lv_coord_t rect_h = LV_VER_RES_MAX / BENCH_CACHE_GRAD_CNT;
+    uint32_t i;
+    for (i = 0; i < BENCH_CACHE_GRAD_CNT; i++) {
+        rects[i] = lv_obj_create(scr);
+        lv_obj_set_pos(rects[i], 0, i * rect_h);
+        lv_obj_set_size(rects[i], LV_HOR_RES_MAX, rect_h);
+        lv_obj_clear_flag(rects[i], LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_style_bg_color(rects[i], lv_palette_main(LV_PALETTE_BLUE), 0);
+        lv_obj_set_style_bg_grad_color(rects[i], lv_palette_main(LV_PALETTE_ORANGE), 0);
+        lv_obj_set_style_bg_grad_dir(rects[i], LV_GRAD_DIR_VER, 0);
+    }
+
+    /* A wrapped label taller than the screen redrawn from its top */
+    static char txt[BENCH_CACHE_LINES * 48];
+    size_t len = 0;
+    for (i = 0; i < BENCH_CACHE_LINES; i++) {
+        len += lv_snprintf(txt + len, sizeof(txt) - len, "Line %u of the long text\n", (unsigned)i);
+    }
+    lv_obj_t * label = lv_label_create(scr);
+    lv_obj_set_width(label, LV_HOR_RES_MAX);
+    lv_label_set_text_static(label, txt);
+    run_frame();
+
+#if LV_USE_PARALLEL_REFR
+    /* The jobs run one after another on this thread to measure the overhead without the speedup of threads */
+    static const lv_refr_parallel_t bench_parallel = {
+        .run_cb = parallel_run_serial,
+        .job_cnt = BENCH_PARALLEL_JOBS,
+    };
+    if (parallel) lv_refr_set_parallel(&bench_parallel);
+#else
+    LV_UNUSED(parallel);
+#endif
+    stat_reset();
+
+    uint32_t f;
+    for (f = 0; f < BENCH_CACHE_FRAMES; f++) {
+        lv_obj_invalidate(scr);
+        run_frame();
+    }
+
+#if LV_USE_PARALLEL_REFR
+    lv_refr_set_parallel(NULL);
+#endif
+
+    lv_obj_del(label);
+    for (i = 0; i < BENCH_CACHE_GRAD_CNT; i++) {
+        lv_obj_del(rects[i]);
+    }
+    run_frame();
+#else
+    LV_UNUSED(parallel);
+#endif
+}
+
+#if LV_USE_PARALLEL_REFR
+/**
+ * Run the jobs of the parallel rendering one after another
+ */
+static void parallel_run_serial(lv_refr_parallel_job_cb_t job_cb, void * user_data, uint32_t job_cnt)
+{
+    uint32_t i;
+    for (i = 0; i < job_cnt; i++) {
+        job_cb(i, user_data);
+    }
+}
+#endif
+
+static void stat_reset(void)
+{
+    memset(&stat, 0, sizeof(stat));
+}
+
+static void report_begin(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"hor_res\": %d,\n", LV_HOR_RES_MAX);
+    fprintf(out, "  \"ver_res\": %d,\n", LV_VER_RES_MAX);
+    fprintf(out, "  \"color_depth\": %d,\n", LV_COLOR_DEPTH);
+    fprintf(out, "  \"frame_period_ms\": %d,\n", BENCH_FRAME_PERIOD);
+    fprintf(out, "  \"setup_ui_us\": %u,\n", (unsigned)setup_ui_us);
+    fprintf(out, "  \"heap_pool_used_after_setup\": %u,\n", (unsigned)(mon.total_size - mon.free_size));
+    fprintf(out, "  \"screens\": [");
+}
+
+static void report_screen(const bench_screen_t * screen, bool first)
+{
+    fprintf(out, "%s\n    {\n      \"name\": \"%s\",\n      \"scenarios\": [", first ? "" : ",", screen->name);
+}
+
+/**
+ * Print the frame time percentiles, the draw calls and the heap usage of the last scenario
+ */
+static void report_scenario(const char * name, bool first)
+{
+    uint32_t n = stat.frame_cnt;
+    uint64_t sum = 0;
+    uint32_t i;
+    for (i = 0; i < n; i++) sum += stat.frame_us[i];
+    qsort(stat.frame_us, n, sizeof(stat.frame_us[0]), cmp_u32);
+
+    /* Nearest rank percentiles */
+#define PERCENTILE(p) (n ? stat.frame_us[((n * (p) + 99) / 100) - 1] : 0)
+
+    fprintf(out, "%s\n        {\n", first ? "" : ",");
+    fprintf(out, "          \"name\": \"%s\",\n", name);
+    fprintf(out, "          \"frames\": %u,\n", (unsigned)n);
+    fprintf(out, "          \"frame_us\": {\"min\": %u, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"max\": %u, \"mean\": %u},\n",
+            (unsigned)(n ? stat.frame_us[0] : 0), (unsigned)PERCENTILE(50), (unsigned)PERCENTILE(90),
+            (unsigned)PERCENTILE(99), (unsigned)(n ? stat.frame_us[n - 1] : 0), (unsigned)(n ? sum / n : 0));
+
+    uint32_t draw_total = 0;
+    fprintf(out, "          \"draw_calls\": {");
+    for (i = 0; i < _BENCH_DRAW_LAST; i++) {
+        fprintf(out, "\"%s\": %u, ", draw_names[i], (unsigned)stat.draw_cnt[i]);
+        draw_total += stat.draw_cnt[i];
+    }
+    fprintf(out, "\"total\": %u},\n", (unsigned)draw_total);
+    fprintf(out, "          \"draw_calls_per_frame\": %u,\n", (unsigned)(n ? draw_total / n : 0));
+    fprintf(out, "          \"rendered_px\": %llu,\n", (unsigned long long)stat.px_cnt);
+    if (stat.setup_cnt) {
+        /* Only the creation of the screen, without loading and rendering it */
+        fprintf(out, "          \"setup\": {\"mean_us\": %u, \"heap\": %u},\n",
+                (unsigned)(stat.setup_us / stat.setup_cnt), (unsigned)stat.setup_heap);
+    }
+
+    /* `pool_used` includes the allocator's overhead,
+     * `alloc_peak` is the high-water mark of the allocated bytes since the start of the program */
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    fprintf(out, "          \"heap\": {\"total\": %u, \"pool_used\": %u, \"alloc_peak\": %u, \"frag_pct\": %u}\n",
+            (unsigned)mon.total_size, (unsigned)(mon.total_size - mon.free_size), (unsigned)mon.max_used,
+            (unsigned)mon.frag_pct);
+    fprintf(out, "        }");
+
+#undef PERCENTILE
+}
+
+static void report_end(void)
+{
+    fprintf(out, "\n  ]");
+    report_style_lookup();
+#if LV_USE_VIDEO
+    report_video_yuv();
+#endif
+    fprintf(out, "\n}\n");
+}
+
+/**
+ * Time the lookup of every built-in property in styles of a few sizes.
+ * `linear_ns` is the same lookup scanning the properties one by one, as the styles did before sorting them.
+ */
+static void report_style_lookup(void)
+{
+    static const uint32_t prop_cnts[] = {4, 8, 16, 32, 64};
+
+    fprintf(out, ",\n  \"style_lookup\": [");
+    uint32_t i;
+    for (i = 0; i < sizeof(prop_cnts) / sizeof(prop_cnts[0]); i++) {
+        /* Spread the properties over the whole ID range, set in descending order like the generated code does */
+        lv_style_t style;
+        lv_style_init(&style);
+        uint32_t j;
+        for (j = 0; j < prop_cnts[i]; j++) {
+            lv_style_value_t v = {.num = (int32_t)j};
+            lv_style_set_prop(&style, (lv_style_prop_t)(_LV_STYLE_LAST_BUILT_IN_PROP - j * _LV_STYLE_LAST_BUILT_IN_PROP /
+                                                         prop_cnts[i]), v);
+        }
+
+        volatile int32_t sink = 0;
+        lv_style_value_t v;
+        uint32_t r;
+        lv_style_prop_t prop;
+        uint32_t t = time_us();
+        for (r = 0; r < BENCH_STYLE_ROUNDS; r++) {
+            for (prop = 1; prop <= _LV_STYLE_LAST_BUILT_IN_PROP; prop++) {
+                if (lv_style_get_prop(&style, prop, &v) == LV_STYLE_RES_FOUND) sink += v.num;
+            }
+        }
+        uint32_t sorted_us = time_us() - t;
+
+        t = time_us();
+        for (r = 0; r < BENCH_STYLE_ROUNDS; r++) {
+            for (prop = 1; prop <= _LV_STYLE_LAST_BUILT_IN_PROP; prop++) {
+                if (style_get_prop_linear(&style, prop, &v) == LV_STYLE_RES_FOUND) sink += v.num;
+            }
+        }
+        uint32_t linear_us = time_us() - t;
+        lv_style_reset(&style);
+
+        uint32_t lookup_cnt = BENCH_STYLE_ROUNDS * _LV_STYLE_LAST_BUILT_IN_PROP;
+        fprintf(out, "%s\n    {\"props\": %u, \"ns\": %u, \"linear_ns\": %u}", i == 0 ? "" : ",",
+                (unsigned)prop_cnts[i], (unsigned)((uint64_t)sorted_us * 1000 / lookup_cnt),
+                (unsigned)((uint64_t)linear_us * 1000 / lookup_cnt));
+    }
+    fprintf(out, "\n  ]");
+}
+
+/**
+ * Reference lookup of a non-constant style with more than one property, scanning all the properties
+ */
+static lv_style_res_t style_get_prop_linear(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
+{
+    const uint16_t * props = (const uint16_t *)(style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t));
+    const lv_style_value_t * values = (const lv_style_value_t *)style->v_p.values_and_props;
+    uint32_t i;
+    for (i = 0; i < style->prop_cnt; i++) {
+        if (LV_STYLE_PROP_ID_MASK(props[i]) == prop) {
+            if (props[i] & LV_STYLE_PROP_META_INHERIT) return LV_STYLE_RES_INHERIT;
+            *value = values[i];
+            return LV_STYLE_RES_FOUND;
+        }
+    }
+    return LV_STYLE_RES_NOT_FOUND;
+}
+
+#if LV_USE_VIDEO
+/**
+ * Time the conversion of decoded video frames of a few sizes to a full screen
+ */
+static void report_video_yuv(void)
+{
+    static const lv_point_t src_sizes[] = {{LV_HOR_RES_MAX, LV_VER_RES_MAX}, {1280, 720}, {640, 360}};
+    uint8_t * line_buf = malloc(LV_VIDEO_YUV_LINE_BUF_SIZE(LV_HOR_RES_MAX));
+
+    fprintf(out, ",\n  \"video_yuv\": [");
+    uint32_t i;
+    for (i = 0; i < sizeof(src_sizes) / sizeof(src_sizes[0]); i++) {
+        lv_video_yuv_t yuv;
+        yuv.w = src_sizes[i].x;
+        yuv.h = src_sizes[i].y;
+        yuv.y_stride = yuv.w;
+        yuv.uv_stride = yuv.w / 2;
+
+        /* A gradient covering the whole range of every plane */
+        uint8_t * planes = malloc(yuv.w * yuv.h * 3 / 2);
+        uint32_t j;
+        for (j = 0; j < (uint32_t)(yuv.w * yuv.h * 3 / 2); j++) planes[j] = (uint8_t)(j * 7 + j / yuv.w);
+        yuv.y = planes;
+        yuv.u = planes + yuv.w * yuv.h;
+        yuv.v = yuv.u + yuv.w * yuv.h / 4;
+
+        uint32_t t = time_us();
+        for (j = 0; j < BENCH_YUV_CNT; j++) {
+            lv_video_yuv_convert(&yuv, frame_buf, LV_HOR_RES_MAX, LV_VER_RES_MAX,
+                                 LV_COLOR_DEPTH == 32 ? LV_VIDEO_YUV_OUT_ARGB8888 : LV_VIDEO_YUV_OUT_RGB565, line_buf);
+        }
+        uint32_t frame_us = LV_MAX((time_us() - t) / BENCH_YUV_CNT, 1);
+        free(planes);
+
+        fprintf(out, "%s\n    {\"src\": \"%dx%d\", \"frame_us\": %u, \"mpix_per_s\": %u}", i == 0 ? "" : ",",
+                (int)yuv.w, (int)yuv.h, (unsigned)frame_us, (unsigned)(LV_HOR_RES_MAX * LV_VER_RES_MAX / frame_us));
+    }
+    fprintf(out, "\n  ]");
+
+    free(line_buf);
+}
+#endif
+
+static int cmp_u32(const void * a, const void * b)
+{
+    uint32_t va = *(const uint32_t *)a;
+    uint32_t vb = *(const uint32_t *)b;
+    return va < vb ? -1 : va > vb ? 1 : 0;
+}
@@ -14,6 +14,8 @@
 #include <limits.h>
 #include <errno.h>
 #include <poll.h>
+#include <signal.h>
+#include <time.h>
 #include "lvgl.h"
 #include "lv_drivers/wayland/wayland.h"
 #include "gui_guider.h"
@@ -37,10 +39,45 @@ int sleep_time;
 static bool close_cb(lv_disp_t * disp);
 static void hal_init(void);
 static void * tick_thread(void * data);
+#if LV_USE_PARALLEL_REFR
+static void parallel_refr_init(void);
+static void parallel_run(lv_refr_parallel_job_cb_t job_cb, void * user_data, uint32_t job_cnt);
+static bool parallel_run_next_job(void);
+static void parallel_lock(void);
+static void parallel_unlock(void);
+static void * render_thread(void * data);
+#endif
+#if LV_USE_PROFILER
+static void profiler_init(void);
+static uint32_t profiler_tick_get(void);
+static uint32_t profiler_tid_get(void);
+static void profiler_sigusr1(int sig);
+static void profiler_write(const char * str, void * user_data);
+static void profiler_dump(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_PARALLEL_REFR
+static lv_refr_parallel_t parallel_refr;
+static pthread_mutex_t render_mutex;    /*Recursive, protects the shared resources of LVGL*/
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_start_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done_cond = PTHREAD_COND_INITIALIZER;
+static lv_refr_parallel_job_cb_t pool_job_cb;
+static void * pool_user_data;
+static uint32_t pool_job_cnt;
+static uint32_t pool_job_next;
+static uint32_t pool_job_done;
+static uint32_t pool_generation;
+#endif
+#if LV_USE_PROFILER
+static const char * profiler_path;          /*Trace file from the GUI_GUIDER_TRACE environment variable*/
+static volatile sig_atomic_t profiler_dump_req;
+static uint32_t profiler_tid_cnt;
+static __thread uint32_t profiler_tid;
+#endif
 
 /**********************
  *      MACROS
@@ -78,6 +115,13 @@ int main(int argc, char ** argv)
         time_till_next = lv_wayland_timer_handler();
 #if LV_USE_VIDEO
         video_play(&guider_ui);
+#endif
+#if LV_USE_PROFILER
+        /* Write the trace on `kill -USR1 <pid>` */
+        if (profiler_dump_req) {
+            profiler_dump_req = 0;
+            profiler_dump();
+        }
 #endif
         /* Run until the last window closes */
         if (!lv_wayland_window_is_open(NULL)) {
@@ -94,6 +138,10 @@ int main(int argc, char ** argv)
         while ((poll(&pfd, 1, sleep_time) < 0) && (errno == EINTR));
     }
 
+#if LV_USE_PROFILER
+    profiler_dump();
+#endif
+
     return 0;
 }
 
@@ -114,6 +162,16 @@ static void hal_init(void)
     /* Create a display */
     lv_disp_t * disp = lv_wayland_create_window(LV_HOR_RES_MAX, LV_VER_RES_MAX, "GUI Guider", close_cb);
 
+#if LV_USE_PARALLEL_REFR
+    /* Render the frames on all the cores */
+    parallel_refr_init();
+#endif
+
+#if LV_USE_PROFILER
+    /* Record a trace if GUI_GUIDER_TRACE=<file> is set */
+    profiler_init();
+#endif
+
     /* Tick init.
      * You have to call 'lv_tick_inc()' in periodically to inform LittelvGL about how much time were elapsed
      */
@@ -139,3 +197,178 @@ static void * tick_thread(void * data)
         lv_tick_inc(5); /*Tell LittelvGL that 5 milliseconds were elapsed*/
     }
 }
+
+#if LV_USE_PARALLEL_REFR
+/**
+ * Start a render thread on every additional core and give them to LVGL.
+ * The thread calling lv_wayland_timer_handler() renders a band too.
+ */
+static void parallel_refr_init(void)
+{
+    long core_cnt = sysconf(_SC_NPROCESSORS_ONLN);
+    if (core_cnt < 2) {
+        return;
+    }
+
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&render_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+
+    long i;
+    for (i = 1; i < core_cnt; i++) {
+        pthread_t tid;
+        int err = pthread_create(&tid, NULL, &render_thread, NULL);
+        if (err != 0) {
+            printf("\ncan't create render thread :[%s]", strerror(err));
+            break;
+        }
+        pthread_detach(tid);
+    }
+
+    if (i < 2) {
+        return;
+    }
+
+    parallel_refr.run_cb = parallel_run;
+    parallel_refr.lock_cb = parallel_lock;
+    parallel_refr.unlock_cb = parallel_unlock;
+    parallel_refr.job_cnt = i;
+    lv_refr_set_parallel(&parallel_refr);
+}
+
+/**
+ * Run the jobs on the render threads and the calling thread and wait for all of them
+ */
+static void parallel_run(lv_refr_parallel_job_cb_t job_cb, void * user_data, uint32_t job_cnt)
+{
+    pthread_mutex_lock(&pool_mutex);
+    pool_job_cb = job_cb;
+    pool_user_data = user_data;
+    pool_job_cnt = job_cnt;
+    pool_job_next = 0;
+    pool_job_done = 0;
+    pool_generation++;
+    pthread_cond_broadcast(&pool_start_cond);
+
+    while (parallel_run_next_job());
+    while (pool_job_done < pool_job_cnt) {
+        pthread_cond_wait(&pool_done_cond, &pool_mutex);
+    }
+    pthread_mutex_unlock(&pool_mutex);
+}
+
+/**
+ * Take the next job and run it. `pool_mutex` has to be locked.
+ * @return false if there are no more jobs
+ */
+static bool parallel_run_next_job(void)
+{
+    if (pool_job_next >= pool_job_cnt) {
+        return false;
+    }
+
+    uint32_t job_id = pool_job_next++;
+    pthread_mutex_unlock(&pool_mutex);
+    pool_job_cb(job_id, pool_user_data);
+    pthread_mutex_lock(&pool_mutex);
+
+    pool_job_done++;
+    if (pool_job_done == pool_job_cnt) {
+        pthread_cond_signal(&pool_done_cond);
+    }
+    return true;
+}
+
+static void parallel_lock(void)
+{
+    pthread_mutex_lock(&render_mutex);
+}
+
+static void parallel_unlock(void)
+{
+    pthread_mutex_unlock(&render_mutex);
+}
+
+/**
+ * A render thread. Runs the jobs of every parallel_run() call.
+ * @param data unused
+ * @return never return
+ */
+static void * render_thread(void * data)
+{
+    (void)data;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&pool_mutex);
+    while (1) {
+        while (generation == pool_generation) {
+            pthread_cond_wait(&pool_start_cond, &pool_mutex);
+        }
+        generation = pool_generation;
+        while (parallel_run_next_job());
+    }
+}
+#endif
+
+#if LV_USE_PROFILER
+/**
+ * Start the profiler if the GUI_GUIDER_TRACE environment variable names a trace file.
+ * The trace is written on exit and on SIGUSR1 in Chrome trace format.
+ */
+static void profiler_init(void)
+{
+    profiler_path = getenv("GUI_GUIDER_TRACE");
+    if (profiler_path == NULL || profiler_path[0] == '\0') return;
+
+    lv_profiler_set_tick_cb(profiler_tick_get, 1000000);
+    lv_profiler_set_tid_cb(profiler_tid_get);
+    signal(SIGUSR1, profiler_sigusr1);
+    lv_profiler_enable(true);
+}
+
+/**
+ * Time stamp of the profiler events in microseconds
+ */
+static uint32_t profiler_tick_get(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+/**
+ * Number the threads in the order they record their first event
+ */
+static uint32_t profiler_tid_get(void)
+{
+    if (profiler_tid == 0) profiler_tid = __atomic_add_fetch(&profiler_tid_cnt, 1, __ATOMIC_RELAXED);
+    return profiler_tid;
+}
+
+static void profiler_sigusr1(int sig)
+{
+    (void)sig;
+    profiler_dump_req = 1;
+}
+
+static void profiler_write(const char * str, void * user_data)
+{
+    fputs(str, user_data);
+}
+
+static void profiler_dump(void)
+{
+    if (profiler_path == NULL || profiler_path[0] == '\0') return;
+
+    FILE * f = fopen(profiler_path, "w");
+    if (f == NULL) {
+        printf("can't open the trace file %s\n", profiler_path);
+        return;
+    }
+    lv_profiler_dump(profiler_write, f);
+    fclose(f);
+    printf("trace written to %s\n", profiler_path);
+}
+#endif
@@ -29,8 +29,11 @@
 #include "vglite_support.h"
 #endif
 
+#include "draw/sw/lv_draw_sw.h"
+
 #if LV_USE_GPU_NXP_PXP
 #include "draw/nxp/pxp/lv_draw_pxp_blend.h"
+#include "draw/nxp/pxp/lv_gpu_nxp_pxp_osa.h"
 #endif
 
 #if (DEMO_DISPLAY_CONTROLLER == DEMO_DISPLAY_CONTROLLER_LCDIFV2)
@@ -52,6 +55,80 @@
 #endif
 #endif
 
+/*
+ * Let LVGL draw directly in the frame buffers in the rotated layout, instead
+ * of drawing in the LVGL buffer and rotating it to the frame buffer. It saves
+ * the rotation pass and the LVGL buffer, but only the software draw context
+ * supports the rotated layout, so PXP and VGLite are not used to draw then.
+ * Opt-in, it pays off only for screens drawn mostly by the CPU anyway.
+ */
+#ifndef DEMO_USE_NATIVE_ROTATE
+#define DEMO_USE_NATIVE_ROTATE 0
+#endif
+
+/* The LVGL buffer is rotated to the frame buffer after drawing. */
+#if DEMO_USE_ROTATE && !DEMO_USE_NATIVE_ROTATE
+#define DEMO_USE_ROTATE_PASS 1
+#else
+#define DEMO_USE_ROTATE_PASS 0
+#endif
+
+/*
+ * Only redraw and flush the invalidated areas instead of the whole frame.
+ * LVGL works in direct mode, the areas flushed since a frame buffer was last
+ * rendered are copied to it before it is rendered again.
+ */
+#ifndef DEMO_USE_PARTIAL_REFRESH
+#define DEMO_USE_PARTIAL_REFRESH 1
+#endif
+
+/*
+ * Do not block LVGL until the frame is shown, the flush is completed from the
+ * interrupts. With rotation the PXP completion queues the frame buffer and
+ * releases the LVGL buffer. Without rotation LVGL is released at once if a
+ * frame buffer is free, otherwise when the display controller frees one.
+ */
+#ifndef DEMO_USE_ASYNC_FLUSH
+#define DEMO_USE_ASYNC_FLUSH 1
+#endif
+
+/* Number of frame buffers passed to the display controller, 2 to 4. */
+#ifndef DEMO_FB_COUNT
+#define DEMO_FB_COUNT 2
+#endif
+
+#if (DEMO_FB_COUNT < 2) || (DEMO_FB_COUNT > 4)
+#error "DEMO_FB_COUNT must be 2 to 4"
+#endif
+
+/* Frame buffer swap policy used after initialization, see lv_port_swap_policy_t. */
+#ifndef DEMO_SWAP_POLICY
+#define DEMO_SWAP_POLICY kLV_PORT_SwapFifo
+#endif
+
+/* Asynchronous rotation needs the PXP completion interrupt. */
+#if DEMO_USE_ASYNC_FLUSH && DEMO_USE_ROTATE_PASS && !(LV_USE_GPU_NXP_PXP && LV_USE_GPU_NXP_PXP_AUTO_INIT)
+#undef DEMO_USE_ASYNC_FLUSH
+#define DEMO_USE_ASYNC_FLUSH 0
+#endif
+
+/*
+ * Show a playing lv_video on a layer of the display controller above the LVGL
+ * layer, LVGL then doesn't draw the video area. The layer scans out the video
+ * frames as they are, so the frame buffer layout must not be rotated.
+ */
+#ifndef DEMO_USE_VIDEO_OVERLAY
+#if LV_USE_VIDEO && (DEMO_DISPLAY_CONTROLLER == DEMO_DISPLAY_CONTROLLER_LCDIFV2) && !DEMO_USE_ROTATE && \
+    ((LV_COLOR_DEPTH == 32) || ((LV_COLOR_DEPTH == 16) && !LV_COLOR_16_SWAP))
+#define DEMO_USE_VIDEO_OVERLAY 1
+#else
+#define DEMO_USE_VIDEO_OVERLAY 0
+#endif
+#endif
+
+/* Display controller layer of the video overlay. */
+#define DEMO_VIDEO_LAYER 1U
+
 /* Cache line size. */
 #ifndef FSL_FEATURE_L2CACHE_LINESIZE_BYTE
 #define FSL_FEATURE_L2CACHE_LINESIZE_BYTE 0
@@ -88,6 +165,32 @@
 #define LVGL_BUFFER_HEIGHT DEMO_BUFFER_HEIGHT
 #endif
 
+/* Buffer rows y1..y2, empty when y1 > y2. */
+typedef struct _demo_rows
+{
+    int32_t y1;
+    int32_t y2;
+} demo_rows_t;
+
+/* Frame buffer state in the ring. */
+typedef enum _demo_fb_state
+{
+    kDEMO_FbFree = 0U, /* Can be rendered. */
+    kDEMO_FbRender,    /* Being rendered. */
+    kDEMO_FbReady,     /* Rendered, waiting for the display controller. */
+    kDEMO_FbPending,   /* Passed to the display controller, shown from the next frame. */
+    kDEMO_FbShown,     /* Scanned out by the display controller. */
+} demo_fb_state_t;
+
+#if DEMO_USE_PARTIAL_REFRESH
+/* Areas changed since a frame buffer was last rendered. */
+typedef struct _demo_dirty_areas
+{
+    lv_area_t areas[LV_INV_BUF_SIZE];
+    uint32_t count;
+} demo_dirty_areas_t;
+#endif
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -111,6 +214,62 @@ static void BOARD_ConfigMIPIPanelTouchIntPin(gt911_int_pin_mode_t mode);
 
 static void DEMO_WaitBufferSwitchOff(void);
 
+static void DEMO_CleanInvalidateRows(void *buffer, uint32_t strideBytes, const demo_rows_t *rows);
+
+static void DEMO_AddRows(demo_rows_t *rows, int32_t y1, int32_t y2);
+
+#if DEMO_USE_ROTATE_PASS && (LV_USE_GPU_NXP_VG_LITE || LV_USE_GPU_NXP_PXP)
+static void DEMO_CleanInvalidateDirtyRows(void);
+#endif
+
+#if DEMO_USE_ROTATE_PASS
+static void DEMO_RotateArea(void *frameBuffer, const lv_area_t *area, const lv_color_t *color_p);
+#endif
+
+static int8_t DEMO_TakeFrameBuffer(void);
+
+static uint8_t DEMO_AcquireFrameBuffer(void);
+
+static void DEMO_SubmitFrameBuffer(uint8_t index);
+
+static void DEMO_PresentFrameBuffer(uint8_t index);
+
+#if !DEMO_USE_ROTATE_PASS
+static void DEMO_SetDrawBuffer(lv_disp_drv_t *disp_drv, uint8_t index);
+
+static void DEMO_StartRender(lv_disp_drv_t *disp_drv);
+
+static void DEMO_GetFrameBufferArea(const lv_area_t *area, lv_area_t *fbArea);
+#endif
+
+#if DEMO_USE_PARTIAL_REFRESH
+static bool DEMO_IsAreaRedrawn(const lv_area_t *area);
+
+static void DEMO_AddDirtyArea(const lv_area_t *area);
+
+static void DEMO_SyncDirtyAreas(lv_disp_drv_t *disp_drv);
+#endif
+
+#if DEMO_USE_ASYNC_FLUSH
+static void DEMO_WaitFlush(lv_disp_drv_t *disp_drv);
+#endif
+
+#if DEMO_USE_ROTATE_PASS && DEMO_USE_ASYNC_FLUSH
+static void DEMO_RotateCompleteCallback(void *param);
+#endif
+
+#if DEMO_USE_VIDEO_OVERLAY
+static bool DEMO_VideoOverlayOpen(lv_obj_t *obj, lv_coord_t w, lv_coord_t h);
+
+static void DEMO_VideoOverlayMove(lv_obj_t *obj, const lv_area_t *area);
+
+static void DEMO_VideoOverlayShow(lv_obj_t *obj, const void *buf);
+
+static void DEMO_VideoOverlayClose(lv_obj_t *obj);
+
+static void DEMO_VideoSwitchOffCallback(void *param, void *switchOffBuffer);
+#endif
+
 #if ((LV_COLOR_DEPTH == 8) || (LV_COLOR_DEPTH == 1))
 /*
  * To support 8 color depth and 1 color depth with this board, color palette is
@@ -122,16 +281,16 @@ static void DEMO_SetLcdColorPalette(void);
 /*******************************************************************************
  * Variables
  ******************************************************************************/
-SDK_ALIGN(static uint8_t s_frameBuffer[2][DEMO_FB_SIZE], DEMO_FB_ALIGN);
-#if DEMO_USE_ROTATE
+SDK_ALIGN(static uint8_t s_frameBuffer[DEMO_FB_COUNT][DEMO_FB_SIZE], DEMO_FB_ALIGN);
+#if DEMO_USE_ROTATE_PASS
 SDK_ALIGN(static uint8_t s_lvglBuffer[1][DEMO_FB_SIZE], DEMO_FB_ALIGN);
 #endif
 
 #if __CORTEX_M == 4
 #define DEMO_FLUSH_DCACHE() L1CACHE_CleanInvalidateSystemCache()
 #else
-#if DEMO_USE_ROTATE
-#define DEMO_FLUSH_DCACHE() SCB_CleanInvalidateDCache_by_Addr(s_lvglBuffer[0], DEMO_FB_SIZE)
+#if DEMO_USE_ROTATE_PASS
+#define DEMO_FLUSH_DCACHE() DEMO_CleanInvalidateDirtyRows()
 #else
 #define DEMO_FLUSH_DCACHE() SCB_CleanInvalidateDCache()
 #endif
@@ -143,13 +302,70 @@ static SemaphoreHandle_t s_transferDone;
 static volatile bool s_transferDone;
 #endif
 
-#if DEMO_USE_ROTATE
 /*
- * When rotate is used, LVGL stack draws in one buffer (s_lvglBuffer), and LCD
- * driver uses two buffers (s_frameBuffer) to remove tearing effect.
+ * Frame buffer ring. The frame buffer being rendered is taken from the free
+ * ones, the rendered frames are queued and passed to the display controller
+ * one by one, when the previous one is shown. The indexes are -1 when no frame
+ * buffer is in that state.
+ *
+ * With the rotate pass, LVGL stack draws in one buffer (s_lvglBuffer) which is
+ * rotated to the frame buffer being rendered. Otherwise LVGL draws directly in
+ * the frame buffer being rendered, rotated if DEMO_USE_NATIVE_ROTATE is used.
+ */
+static volatile demo_fb_state_t s_fbState[DEMO_FB_COUNT];
+static volatile uint8_t s_fbReadyQueue[DEMO_FB_COUNT];
+static volatile uint8_t s_fbReadyCount;
+static volatile int8_t s_fbRender  = -1;
+static volatile int8_t s_fbPending = -1;
+static volatile int8_t s_fbShown   = -1;
+static volatile lv_port_swap_policy_t s_swapPolicy = DEMO_SWAP_POLICY;
+
+/* Frame buffer ring statistics. */
+static volatile uint32_t s_shownFrames;
+static volatile uint32_t s_droppedFrames;
+static volatile uint32_t s_renderStalls;
+
+#if DEMO_USE_PARTIAL_REFRESH
+/*
+ * Areas changed since each frame buffer was last rendered. They are copied to
+ * the frame buffer before it is rendered again, except the redrawn ones.
  */
-static void *volatile s_inactiveFrameBuffer;
+static demo_dirty_areas_t s_fbDirtyAreas[DEMO_FB_COUNT];
 #endif
+
+#if !DEMO_USE_ROTATE_PASS && DEMO_USE_PARTIAL_REFRESH
+/* Last presented frame buffer, it has the newest content. */
+static int8_t s_fbLatest = -1;
+
+/* Rows written to the frame buffer being rendered. */
+static demo_rows_t s_renderRows;
+#endif
+
+#if !DEMO_USE_ROTATE_PASS && DEMO_USE_ASYNC_FLUSH
+/* Display driver waiting for a free frame buffer. */
+static lv_disp_drv_t *volatile s_flushingDispDrv;
+#endif
+
+#if DEMO_USE_VIDEO_OVERLAY
+static const lv_video_overlay_t s_videoOverlay = {
+    .open_cb  = DEMO_VideoOverlayOpen,
+    .move_cb  = DEMO_VideoOverlayMove,
+    .show_cb  = DEMO_VideoOverlayShow,
+    .close_cb = DEMO_VideoOverlayClose,
+};
+
+/* The video shown on the overlay layer and its frame size. */
+static lv_obj_t *s_videoObj;
+static lv_coord_t s_videoWidth;
+static lv_coord_t s_videoHeight;
+/* Frame buffer last passed to the overlay layer. */
+static const void *s_videoBuf;
+static bool s_videoLayerEnabled;
+#endif
+
+/* D-cache bytes cleaned and invalidated in the current and in the last frame. */
+static uint32_t s_dcacheCleanBytes;
+static uint32_t s_dcacheCleanBytesLastFrame;
 #if (DEMO_PANEL != DEMO_PANEL_RASPI_7INCH)
 static gt911_handle_t s_touchHandle;
 static const gt911_config_t s_touchConfig = {
@@ -228,11 +444,15 @@ void lv_port_disp_init(void)
     static lv_disp_draw_buf_t disp_buf;
 
     memset(s_frameBuffer, 0, sizeof(s_frameBuffer));
-#if DEMO_USE_ROTATE
+#if DEMO_USE_ROTATE_PASS
     memset(s_lvglBuffer, 0, sizeof(s_lvglBuffer));
     lv_disp_draw_buf_init(&disp_buf, s_lvglBuffer[0], NULL, DEMO_BUFFER_WIDTH * DEMO_BUFFER_HEIGHT);
 #else
-    lv_disp_draw_buf_init(&disp_buf, s_frameBuffer[0], s_frameBuffer[1], DEMO_BUFFER_WIDTH * DEMO_BUFFER_HEIGHT);
+    /*
+     * LVGL sees one buffer, the frame buffer being rendered is set as the draw
+     * buffer each time LVGL is released from a flush.
+     */
+    lv_disp_draw_buf_init(&disp_buf, s_frameBuffer[0], NULL, DEMO_BUFFER_WIDTH * DEMO_BUFFER_HEIGHT);
 #endif
 
     status_t status;
@@ -280,13 +500,18 @@ void lv_port_disp_init(void)
     s_transferDone = false;
 #endif
 
-#if DEMO_USE_ROTATE
-    /* s_frameBuffer[1] is first shown in the panel, s_frameBuffer[0] is inactive. */
-    s_inactiveFrameBuffer = (void *)s_frameBuffer[0];
+#if !DEMO_USE_ROTATE_PASS && DEMO_USE_PARTIAL_REFRESH
+    s_renderRows.y1 = 0;
+    s_renderRows.y2 = -1;
+#endif
+
+#if !DEMO_USE_ROTATE_PASS
+    /* lvgl starts render in frame buffer 0. */
+    s_fbRender = DEMO_TakeFrameBuffer();
 #endif
 
-    /* lvgl starts render in frame buffer 0, so show frame buffer 1 first. */
-    g_dc.ops->setFrameBuffer(&g_dc, 0, (void *)s_frameBuffer[1]);
+    /* Show the last frame buffer first. */
+    DEMO_SubmitFrameBuffer(DEMO_FB_COUNT - 1U);
 
     /* Wait for frame buffer sent to display controller video memory. */
     if ((g_dc.ops->getProperty(&g_dc) & kDC_FB_ReserveFrameBuffer) == 0)
@@ -312,19 +537,46 @@ void lv_port_disp_init(void)
     /*Used to copy the buffer's content to the display*/
     disp_drv.flush_cb = DEMO_FlushDisplay;
 
+#if !DEMO_USE_ROTATE_PASS
+    /*Used to prepare the frame buffer to render*/
+    disp_drv.render_start_cb = DEMO_StartRender;
+#endif
+
 #if (LV_USE_GPU_NXP_VG_LITE || LV_USE_GPU_NXP_PXP)
     disp_drv.clean_dcache_cb = DEMO_CleanInvalidateCache;
 #endif
 
+#if DEMO_USE_ASYNC_FLUSH
+    /*Used to wait for the flush completed in interrupt*/
+    disp_drv.wait_cb = DEMO_WaitFlush;
+#endif
+
     /*Set a display buffer*/
     disp_drv.draw_buf = &disp_buf;
 
-    /* Partial refresh */
+#if DEMO_USE_ROTATE && DEMO_USE_NATIVE_ROTATE
+    /* Only the software draw context draws in the rotated layout. */
+    disp_drv.draw_ctx_init   = lv_draw_sw_init_ctx;
+    disp_drv.draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    disp_drv.draw_ctx_size   = sizeof(lv_draw_sw_ctx_t);
+#endif
+
+#if DEMO_USE_PARTIAL_REFRESH
+    /* Partial refresh, only the invalidated areas are drawn and flushed. */
+    disp_drv.direct_mode = 1;
+#else
+    /* Full refresh */
     disp_drv.full_refresh = 1;
+#endif
 
     /*Finally register the driver*/
     lv_disp_drv_register(&disp_drv);
 
+#if DEMO_USE_ROTATE && DEMO_USE_NATIVE_ROTATE
+    /* The frame buffer is scanned out in portrait, LVGL draws landscape in it rotated by 270 degrees. */
+    disp_drv.draw_ctx->buf_rot_270 = 1;
+#endif
+
 #if LV_USE_GPU_NXP_VG_LITE
     if (vg_lite_init(DEFAULT_VG_LITE_TW_WIDTH, DEFAULT_VG_LITE_TW_HEIGHT) != VG_LITE_SUCCESS)
     {
@@ -342,10 +594,71 @@ void lv_port_disp_init(void)
             ;
     }
 #endif
+
+#if DEMO_USE_VIDEO_OVERLAY
+    lv_video_set_overlay_driver(&s_videoOverlay);
+#endif
 }
 
 static void DEMO_BufferSwitchOffCallback(void *param, void *switchOffBuffer)
 {
+    uint32_t primask = DisableGlobalIRQ();
+
+    /* The pending frame buffer is shown, the switched off one is free. */
+    if (s_fbShown >= 0)
+    {
+        s_fbState[s_fbShown] = kDEMO_FbFree;
+    }
+
+    s_fbShown   = s_fbPending;
+    s_fbPending = -1;
+
+    if (s_fbShown >= 0)
+    {
+        s_fbState[s_fbShown] = kDEMO_FbShown;
+        s_shownFrames++;
+    }
+
+    /* Pass the oldest rendered frame to the display controller. */
+    if (s_fbReadyCount > 0U)
+    {
+        uint8_t index = s_fbReadyQueue[0];
+
+        s_fbReadyCount--;
+        for (uint8_t i = 0; i < s_fbReadyCount; i++)
+        {
+            s_fbReadyQueue[i] = s_fbReadyQueue[i + 1U];
+        }
+
+        DEMO_SubmitFrameBuffer(index);
+    }
+
+#if !DEMO_USE_ROTATE_PASS && DEMO_USE_ASYNC_FLUSH
+    /* Release LVGL if it waits for a free frame buffer. */
+    lv_disp_drv_t *dispDrv = s_flushingDispDrv;
+    int8_t renderIndex     = -1;
+
+    if (NULL != dispDrv)
+    {
+        renderIndex = DEMO_TakeFrameBuffer();
+
+        if (renderIndex >= 0)
+        {
+            s_flushingDispDrv = NULL;
+        }
+    }
+#endif
+
+    EnableGlobalIRQ(primask);
+
+#if !DEMO_USE_ROTATE_PASS && DEMO_USE_ASYNC_FLUSH
+    if (renderIndex >= 0)
+    {
+        DEMO_SetDrawBuffer(dispDrv, (uint8_t)renderIndex);
+        lv_disp_flush_ready(dispDrv);
+    }
+#endif
+
 #if defined(SDK_OS_FREE_RTOS)
     BaseType_t taskAwake = pdFALSE;
 
@@ -354,12 +667,107 @@ static void DEMO_BufferSwitchOffCallback(void *param, void *switchOffBuffer)
 #else
     s_transferDone = true;
 #endif
+}
 
-#if DEMO_USE_ROTATE
-    s_inactiveFrameBuffer = switchOffBuffer;
-#endif
+#if DEMO_USE_VIDEO_OVERLAY
+static bool DEMO_VideoOverlayOpen(lv_obj_t *obj, lv_coord_t w, lv_coord_t h)
+{
+    lcdifv2_blend_config_t blendConfig = {
+        .globalAlpha = 255U,
+        .alphaMode   = kLCDIFV2_AlphaOverride,
+    };
+
+    /* One video at a time, the others are drawn by LVGL. */
+    if (NULL != s_videoObj)
+    {
+        return false;
+    }
+
+    s_videoObj    = obj;
+    s_videoWidth  = w;
+    s_videoHeight = h;
+    s_videoBuf    = NULL;
+
+    /* The video is opaque, the alpha channel of XRGB8888 is not defined. Loaded when the layer is enabled. */
+    LCDIFV2_SetLayerBlendConfig(LCDIFV2, DEMO_VIDEO_LAYER, &blendConfig);
+
+    g_dc.ops->setCallback(&g_dc, DEMO_VIDEO_LAYER, DEMO_VideoSwitchOffCallback, obj);
+
+    return true;
 }
 
+static void DEMO_VideoOverlayMove(lv_obj_t *obj, const lv_area_t *area)
+{
+    dc_fb_info_t fbInfo;
+
+    if (NULL == area)
+    {
+        g_dc.ops->disableLayer(&g_dc, DEMO_VIDEO_LAYER);
+        s_videoLayerEnabled = false;
+        return;
+    }
+
+    g_dc.ops->getLayerDefaultConfig(&g_dc, DEMO_VIDEO_LAYER, &fbInfo);
+    fbInfo.pixelFormat = DEMO_BUFFER_PIXEL_FORMAT;
+    fbInfo.width       = s_videoWidth;
+    fbInfo.height      = s_videoHeight;
+    fbInfo.startX      = DEMO_BUFFER_START_X + area->x1;
+    fbInfo.startY      = DEMO_BUFFER_START_Y + area->y1;
+    fbInfo.strideBytes = s_videoWidth * DEMO_BUFFER_BYTE_PER_PIXEL;
+    g_dc.ops->setLayerConfig(&g_dc, DEMO_VIDEO_LAYER, &fbInfo);
+
+    /* The new position is loaded with a frame buffer. */
+    if (s_videoLayerEnabled)
+    {
+        g_dc.ops->setFrameBuffer(&g_dc, DEMO_VIDEO_LAYER, (void *)s_videoBuf);
+    }
+}
+
+static void DEMO_VideoOverlayShow(lv_obj_t *obj, const void *buf)
+{
+    const void *oldBuf = s_videoBuf;
+
+    s_videoBuf = buf;
+
+    /* The switched off buffer is released in the interrupt. */
+    g_dc.ops->setFrameBuffer(&g_dc, DEMO_VIDEO_LAYER, (void *)buf);
+
+    if (!s_videoLayerEnabled)
+    {
+        /* The hidden layer doesn't read the previous buffer. */
+        if ((NULL != oldBuf) && (oldBuf != buf))
+        {
+            lv_video_overlay_release(obj, oldBuf);
+        }
+
+        g_dc.ops->enableLayer(&g_dc, DEMO_VIDEO_LAYER);
+        s_videoLayerEnabled = true;
+    }
+}
+
+static void DEMO_VideoOverlayClose(lv_obj_t *obj)
+{
+    g_dc.ops->disableLayer(&g_dc, DEMO_VIDEO_LAYER);
+    s_videoLayerEnabled = false;
+
+    /* A pending buffer switch must not release a frame of the deleted video. */
+    uint32_t primask = DisableGlobalIRQ();
+    g_dc.ops->setCallback(&g_dc, DEMO_VIDEO_LAYER, DEMO_VideoSwitchOffCallback, NULL);
+    EnableGlobalIRQ(primask);
+
+    s_videoObj = NULL;
+    s_videoBuf = NULL;
+}
+
+static void DEMO_VideoSwitchOffCallback(void *param, void *switchOffBuffer)
+{
+    if ((NULL != param) && (NULL != switchOffBuffer))
+    {
+        lv_video_overlay_release((lv_obj_t *)param, switchOffBuffer);
+    }
+}
+#endif
+
 #if (LV_USE_GPU_NXP_VG_LITE || LV_USE_GPU_NXP_PXP)
 static void DEMO_CleanInvalidateCache(lv_disp_drv_t *disp_drv)
 {
@@ -367,6 +775,257 @@ static void DEMO_CleanInvalidateCache(lv_disp_drv_t *disp_drv)
 }
 #endif
 
+/* Clean and invalidate the D-cache of the buffer rows only. */
+static void DEMO_CleanInvalidateRows(void *buffer, uint32_t strideBytes, const demo_rows_t *rows)
+{
+    if (rows->y1 > rows->y2)
+    {
+        return;
+    }
+
+    uint32_t size = (uint32_t)(rows->y2 - rows->y1 + 1) * strideBytes;
+
+    SCB_CleanInvalidateDCache_by_Addr((uint8_t *)buffer + (uint32_t)rows->y1 * strideBytes, (int32_t)size);
+
+    s_dcacheCleanBytes += size;
+}
+
+/* Extend the rows to also cover y1..y2. */
+static void DEMO_AddRows(demo_rows_t *rows, int32_t y1, int32_t y2)
+{
+    if (y1 > y2)
+    {
+        return;
+    }
+
+    if (rows->y1 > rows->y2)
+    {
+        rows->y1 = y1;
+        rows->y2 = y2;
+    }
+    else
+    {
+        rows->y1 = LV_MIN(rows->y1, y1);
+        rows->y2 = LV_MAX(rows->y2, y2);
+    }
+}
+
+#if DEMO_USE_ROTATE_PASS && (LV_USE_GPU_NXP_VG_LITE || LV_USE_GPU_NXP_PXP)
+/*
+ * Before a GPU operation, only the rows of the LVGL buffer covered by the
+ * areas being refreshed can be dirty. Outside of a refresh clean the whole
+ * buffer.
+ */
+static void DEMO_CleanInvalidateDirtyRows(void)
+{
+    lv_disp_t *disp  = _lv_refr_get_disp_refreshing();
+    demo_rows_t rows = {.y1 = 0, .y2 = -1};
+
+    if ((disp != NULL) && (disp->inv_p != 0U))
+    {
+        for (uint16_t i = 0; i < disp->inv_p; i++)
+        {
+            if (disp->inv_area_joined[i] == 0U)
+            {
+                DEMO_AddRows(&rows, disp->inv_areas[i].y1, disp->inv_areas[i].y2);
+            }
+        }
+
+        rows.y1 = LV_MAX(rows.y1, 0);
+        rows.y2 = LV_MIN(rows.y2, LVGL_BUFFER_HEIGHT - 1);
+    }
+    else
+    {
+        rows.y2 = LVGL_BUFFER_HEIGHT - 1;
+    }
+
+    DEMO_CleanInvalidateRows(s_lvglBuffer[0], LVGL_BUFFER_WIDTH * LCD_FB_BYTE_PER_PIXEL, &rows);
+}
+#endif
+
+uint32_t lv_port_get_dcache_clean_bytes(void)
+{
+    return s_dcacheCleanBytesLastFrame;
+}
+
+void lv_port_set_swap_policy(lv_port_swap_policy_t policy)
+{
+    s_swapPolicy = policy;
+}
+
+void lv_port_get_fb_state(lv_port_fb_state_t *state)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    state->bufferCount = DEMO_FB_COUNT;
+    state->freeCount   = 0U;
+    state->readyCount  = s_fbReadyCount + ((s_fbPending >= 0) ? 1U : 0U);
+    state->policy      = s_swapPolicy;
+
+    for (uint8_t i = 0; i < DEMO_FB_COUNT; i++)
+    {
+        if (kDEMO_FbFree == s_fbState[i])
+        {
+            state->freeCount++;
+        }
+    }
+
+    state->shownFrames   = s_shownFrames;
+    state->droppedFrames = s_droppedFrames;
+    state->renderStalls  = s_renderStalls;
+
+    EnableGlobalIRQ(primask);
+}
+
+/* Take a free frame buffer to render, return -1 if there is none. */
+static int8_t DEMO_TakeFrameBuffer(void)
+{
+    int8_t index     = -1;
+    uint32_t primask = DisableGlobalIRQ();
+
+    /* Vsync-locked: render the next frame only when the previous one is shown. */
+    if ((kLV_PORT_SwapVsync != s_swapPolicy) || ((s_fbPending < 0) && (0U == s_fbReadyCount)))
+    {
+        for (uint8_t i = 0; i < DEMO_FB_COUNT; i++)
+        {
+            if (kDEMO_FbFree == s_fbState[i])
+            {
+                s_fbState[i] = kDEMO_FbRender;
+                index        = (int8_t)i;
+                break;
+            }
+        }
+    }
+
+    EnableGlobalIRQ(primask);
+
+    return index;
+}
+
+/* Take a free frame buffer to render, wait for the display if there is none. */
+static uint8_t DEMO_AcquireFrameBuffer(void)
+{
+    int8_t index = DEMO_TakeFrameBuffer();
+
+    if (index < 0)
+    {
+        s_renderStalls++;
+
+        do
+        {
+            DEMO_WaitBufferSwitchOff();
+            index = DEMO_TakeFrameBuffer();
+        } while (index < 0);
+    }
+
+    return (uint8_t)index;
+}
+
+/* Pass the frame buffer to the display controller, called with interrupts disabled. */
+static void DEMO_SubmitFrameBuffer(uint8_t index)
+{
+    s_fbState[index] = kDEMO_FbPending;
+    s_fbPending      = (int8_t)index;
+
+    g_dc.ops->setFrameBuffer(&g_dc, 0, (void *)s_frameBuffer[index]);
+}
+
+/* Queue the rendered frame buffer to be shown. */
+static void DEMO_PresentFrameBuffer(uint8_t index)
+{
+    uint32_t primask = DisableGlobalIRQ();
+
+    if ((s_fbPending < 0) && (0U == s_fbReadyCount))
+    {
+        /* The display controller is idle, show the frame from the next frame. */
+        DEMO_SubmitFrameBuffer(index);
+    }
+    else
+    {
+        /* Mailbox: only the newest frame waits, the older ones are dropped. */
+        if (kLV_PORT_SwapMailbox == s_swapPolicy)
+        {
+            for (uint8_t i = 0; i < s_fbReadyCount; i++)
+            {
+                s_fbState[s_fbReadyQueue[i]] = kDEMO_FbFree;
+                s_droppedFrames++;
+            }
+
+            s_fbReadyCount = 0U;
+        }
+
+        s_fbState[index]                = kDEMO_FbReady;
+        s_fbReadyQueue[s_fbReadyCount] = index;
+        s_fbReadyCount++;
+    }
+
+    EnableGlobalIRQ(primask);
+}
+
+#if !DEMO_USE_ROTATE_PASS
+/* Let LVGL render in the frame buffer. */
+static void DEMO_SetDrawBuffer(lv_disp_drv_t *disp_drv, uint8_t index)
+{
+    s_fbRender = (int8_t)index;
+
+    disp_drv->draw_buf->buf1    = s_frameBuffer[index];
+    disp_drv->draw_buf->buf_act = s_frameBuffer[index];
+}
+
+/* Get the frame buffer area of an area in LVGL coordinates. */
+static void DEMO_GetFrameBufferArea(const lv_area_t *area, lv_area_t *fbArea)
+{
+#if DEMO_USE_ROTATE
+    /* LVGL draws in the frame buffer rotated, see lv_draw_ctx_t::buf_rot_270. */
+    fbArea->x1 = area->y1;
+    fbArea->x2 = area->y2;
+    fbArea->y1 = LVGL_BUFFER_WIDTH - 1 - area->x2;
+    fbArea->y2 = LVGL_BUFFER_WIDTH - 1 - area->x1;
+#else
+    lv_area_copy(fbArea, area);
+#endif
+}
+
+/* Called by LVGL before a frame is rendered. */
+static void DEMO_StartRender(lv_disp_drv_t *disp_drv)
+{
+#if DEMO_USE_ASYNC_FLUSH
+    /* The frame buffer to render is set when the last flush completes. */
+    while (disp_drv->draw_buf->flushing)
+    {
+        DEMO_WaitFlush(disp_drv);
+    }
+#endif
+
+#if DEMO_USE_PARTIAL_REFRESH
+    DEMO_SyncDirtyAreas(disp_drv);
+#endif
+}
+#endif /* !DEMO_USE_ROTATE_PASS */
+
+#if DEMO_USE_ASYNC_FLUSH
+static void DEMO_WaitFlush(lv_disp_drv_t *disp_drv)
+{
+#if DEMO_USE_ROTATE_PASS
+    /* The LVGL buffer is released when PXP completes the rotation. */
+    lv_gpu_nxp_pxp_wait();
+#else
+    /* The LVGL buffer is released when the display controller switches it off. */
+    DEMO_WaitBufferSwitchOff();
+#endif
+}
+#endif
+
+#if DEMO_USE_ROTATE_PASS && DEMO_USE_ASYNC_FLUSH
+/* Called in PXP interrupt when the last area of the frame is rotated. */
+static void DEMO_RotateCompleteCallback(void *param)
+{
+    DEMO_PresentFrameBuffer((uint8_t)s_fbRender);
+
+    lv_disp_flush_ready((lv_disp_drv_t *)param);
+}
+#endif
+
 static void DEMO_WaitBufferSwitchOff(void)
 {
 #if defined(SDK_OS_FREE_RTOS)
@@ -383,80 +1042,271 @@ static void DEMO_WaitBufferSwitchOff(void)
 #endif
 }
 
+#if DEMO_USE_ROTATE_PASS
+/*
+ * Rotate one area of the LVGL buffer to the frame buffer. The area is in LVGL
+ * coordinates, color_p points to the whole LVGL buffer.
+ */
+static void DEMO_RotateArea(void *frameBuffer, const lv_area_t *area, const lv_color_t *color_p)
+{
+    /* Frame buffer rows written by the rotated area. */
+    demo_rows_t rows = {
+        .y1 = LVGL_BUFFER_WIDTH - 1 - area->x2,
+        .y2 = LVGL_BUFFER_WIDTH - 1 - area->x1,
+    };
+
+#if LV_USE_GPU_NXP_PXP /* Use PXP to rotate the panel. */
+    DEMO_CleanInvalidateRows(frameBuffer, DEMO_BUFFER_STRIDE_BYTE, &rows);
+
+    /* Top left corner of the rotated area in the frame buffer. */
+    lv_color_t *dest = (lv_color_t *)frameBuffer + (LVGL_BUFFER_WIDTH - 1 - area->x2) * DEMO_BUFFER_WIDTH + area->y1;
+
+    lv_area_t dest_area = {
+        .x1 = 0,
+        .x2 = lv_area_get_width(area) - 1,
+        .y1 = 0,
+        .y2 = lv_area_get_height(area) - 1,
+    };
+
+    lv_gpu_nxp_pxp_blit(dest, &dest_area, DEMO_BUFFER_WIDTH, color_p, area, LVGL_BUFFER_WIDTH, LV_OPA_COVER,
+                        LV_DISP_ROT_270);
+
+#else /* Use CPU to rotate the panel. */
+    /* The pixel (x, y) goes to the frame buffer row (LVGL_BUFFER_WIDTH - 1 - x), column y. */
+    lv_color_t *dest = (lv_color_t *)frameBuffer + (LVGL_BUFFER_WIDTH - 1 - area->x2) * DEMO_BUFFER_WIDTH + area->y1;
+
+    lv_draw_sw_rotate(color_p + area->y1 * LVGL_BUFFER_WIDTH + area->x1, dest, lv_area_get_width(area),
+                      lv_area_get_height(area), LVGL_BUFFER_WIDTH, DEMO_BUFFER_WIDTH, LV_DISP_ROT_90,
+                      sizeof(lv_color_t));
+
+    DEMO_CleanInvalidateRows(frameBuffer, DEMO_BUFFER_STRIDE_BYTE, &rows);
+#endif
+}
+#endif /* DEMO_USE_ROTATE_PASS */
+
+#if DEMO_USE_PARTIAL_REFRESH
+/* Check whether the area is redrawn in the frame being refreshed. */
+static bool DEMO_IsAreaRedrawn(const lv_area_t *area)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+
+    if (disp == NULL)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < disp->inv_p; i++)
+    {
+        if ((disp->inv_area_joined[i] == 0U) && _lv_area_is_in(area, &disp->inv_areas[i], 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* The flushed area is changed in all the other frame buffers. */
+static void DEMO_AddDirtyArea(const lv_area_t *area)
+{
+    for (uint8_t i = 0; i < DEMO_FB_COUNT; i++)
+    {
+        demo_dirty_areas_t *dirty = &s_fbDirtyAreas[i];
+
+        if (i == (uint8_t)s_fbRender)
+        {
+            continue;
+        }
+
+        if (dirty->count < LV_INV_BUF_SIZE)
+        {
+            lv_area_copy(&dirty->areas[dirty->count], area);
+            dirty->count++;
+        }
+        else
+        {
+            /* No place for the area, sync the whole screen next time. */
+            lv_area_set(&dirty->areas[0], 0, 0, LVGL_BUFFER_WIDTH - 1, LVGL_BUFFER_HEIGHT - 1);
+            dirty->count = 1;
+        }
+    }
+}
+
+/*
+ * Copy the areas changed since the frame buffer being rendered was last
+ * rendered, except the ones redrawn in this frame. With rotation they are
+ * rotated from the LVGL buffer, otherwise copied from the last presented
+ * frame buffer.
+ */
+static void DEMO_SyncDirtyAreas(lv_disp_drv_t *disp_drv)
+{
+    demo_dirty_areas_t *dirty = &s_fbDirtyAreas[s_fbRender];
+
+#if !DEMO_USE_ROTATE_PASS
+    /* No frame buffer presented yet, there is no content to copy from. */
+    if (s_fbLatest < 0)
+    {
+        return;
+    }
+#endif
+
+    for (uint32_t i = 0; i < dirty->count; i++)
+    {
+        if (DEMO_IsAreaRedrawn(&dirty->areas[i]))
+        {
+            continue;
+        }
+
+#if DEMO_USE_ROTATE_PASS
+        DEMO_RotateArea(s_frameBuffer[s_fbRender], &dirty->areas[i], (const lv_color_t *)s_lvglBuffer[0]);
+#else
+        lv_area_t fbArea;
+
+        DEMO_GetFrameBufferArea(&dirty->areas[i], &fbArea);
+
+        disp_drv->draw_ctx->buffer_copy(disp_drv->draw_ctx, s_frameBuffer[s_fbRender], DEMO_BUFFER_WIDTH, &fbArea,
+                                        s_frameBuffer[s_fbLatest], DEMO_BUFFER_WIDTH, &fbArea);
+
+        DEMO_AddRows(&s_renderRows, fbArea.y1, fbArea.y2);
+#endif
+    }
+
+    dirty->count = 0;
+}
+#endif /* DEMO_USE_PARTIAL_REFRESH */
+
 static void DEMO_FlushDisplay(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
-#if DEMO_USE_ROTATE
+#if DEMO_USE_ROTATE_PASS
 
     /*
      * Work flow:
      *
-     * 1. Wait for the available inactive frame buffer to draw.
-     * 2. Draw the ratated frame to inactive buffer.
-     * 3. Pass inactive to LCD controller to show.
+     * 1. Take a free frame buffer to draw, wait if there is none.
+     * 2. Draw the ratated frame to the frame buffer.
+     * 3. Queue the frame buffer to the LCD controller to show.
+     *
+     * In partial refresh mode this function is called for every invalidated
+     * area, step 1 is done for the first area and step 3 for the last one.
+     *
+     * In asynchronous flush mode step 3 is done in the PXP interrupt, when
+     * the rotation of the last area completes.
      */
 
-    static bool firstFlush = true;
+#if DEMO_USE_PARTIAL_REFRESH
+    static bool frameStarted = false;
 
-    /* Only wait for the first time. */
-    if (firstFlush)
+    if (!frameStarted)
+#endif
     {
-        firstFlush = false;
+        s_fbRender = (int8_t)DEMO_AcquireFrameBuffer();
+#if DEMO_USE_PARTIAL_REFRESH
+        frameStarted = true;
+#endif
     }
-    else
+
+    void *frameBuffer = (void *)s_frameBuffer[s_fbRender];
+
+#if DEMO_USE_PARTIAL_REFRESH
+    DEMO_AddDirtyArea(area);
+
+    if (!lv_disp_flush_is_last(disp_drv))
     {
-        /* Wait frame buffer. */
-        DEMO_WaitBufferSwitchOff();
+        /* Copy buffer. */
+        DEMO_RotateArea(frameBuffer, area, color_p);
+
+        lv_disp_flush_ready(disp_drv);
+        return;
     }
 
+    /* Rotate the areas missing in the frame buffer first, the last area is the last rotation. */
+    DEMO_SyncDirtyAreas(disp_drv);
+    frameStarted = false;
+#endif
+
+#if DEMO_USE_ASYNC_FLUSH
+    lv_gpu_nxp_pxp_set_complete_cb(DEMO_RotateCompleteCallback, disp_drv);
+#endif
+
     /* Copy buffer. */
-    void *inactiveFrameBuffer = s_inactiveFrameBuffer;
-    SCB_CleanInvalidateDCache_by_Addr(inactiveFrameBuffer, DEMO_FB_SIZE);
+    DEMO_RotateArea(frameBuffer, area, color_p);
 
-#if LV_USE_GPU_NXP_PXP /* Use PXP to rotate the panel. */
-    lv_area_t dest_area = {
-        .x1 = 0,
-        .x2 = DEMO_BUFFER_HEIGHT - 1,
-        .y1 = 0,
-        .y2 = DEMO_BUFFER_WIDTH - 1,
-    };
+    s_dcacheCleanBytesLastFrame = s_dcacheCleanBytes;
+    s_dcacheCleanBytes          = 0;
 
-    lv_gpu_nxp_pxp_blit(((lv_color_t *)inactiveFrameBuffer), &dest_area, DEMO_BUFFER_WIDTH, color_p, area,
-                        lv_area_get_width(area), LV_OPA_COVER, LV_DISP_ROT_270);
+#if !DEMO_USE_ASYNC_FLUSH
     /* Fix the race issue between PXP and Display controller when VG_Lite is enabled */
-#if LV_USE_GPU_NXP_VG_LITE
+#if LV_USE_GPU_NXP_PXP && LV_USE_GPU_NXP_VG_LITE
     lv_gpu_nxp_pxp_wait();
 #endif
 
-#else /* Use CPU to rotate the panel. */
-    for (uint32_t y = 0; y < LVGL_BUFFER_HEIGHT; y++)
+    DEMO_PresentFrameBuffer((uint8_t)s_fbRender);
+
+    /* IMPORTANT!!!
+     * Inform the graphics library that you are ready with the flushing*/
+    lv_disp_flush_ready(disp_drv);
+#endif
+
+#else  /* DEMO_USE_ROTATE_PASS */
+#if DEMO_USE_PARTIAL_REFRESH
+    lv_area_t fbArea;
+
+    DEMO_GetFrameBufferArea(area, &fbArea);
+    DEMO_AddDirtyArea(area);
+    DEMO_AddRows(&s_renderRows, fbArea.y1, fbArea.y2);
+
+    /* LVGL draws directly in the frame buffer, switch it after the last area. */
+    if (!lv_disp_flush_is_last(disp_drv))
     {
-        for (uint32_t x = 0; x < LVGL_BUFFER_WIDTH; x++)
-        {
-            ((lv_color_t *)inactiveFrameBuffer)[(DEMO_BUFFER_HEIGHT - x) * DEMO_BUFFER_WIDTH + y] =
-                color_p[y * LVGL_BUFFER_WIDTH + x];
-        }
+        lv_disp_flush_ready(disp_drv);
+        return;
     }
+
+    demo_rows_t rows = s_renderRows;
+
+    s_renderRows.y1 = 0;
+    s_renderRows.y2 = -1;
+    s_fbLatest      = s_fbRender;
+#else
+    demo_rows_t rows = {.y1 = 0, .y2 = DEMO_BUFFER_HEIGHT - 1};
 #endif
 
-    SCB_CleanInvalidateDCache_by_Addr(inactiveFrameBuffer, DEMO_FB_SIZE);
+    DEMO_CleanInvalidateRows(color_p, DEMO_BUFFER_STRIDE_BYTE, &rows);
 
-    g_dc.ops->setFrameBuffer(&g_dc, 0, inactiveFrameBuffer);
+    s_dcacheCleanBytesLastFrame = s_dcacheCleanBytes;
+    s_dcacheCleanBytes          = 0;
 
-    /* IMPORTANT!!!
-     * Inform the graphics library that you are ready with the flushing*/
-    lv_disp_flush_ready(disp_drv);
+    DEMO_PresentFrameBuffer((uint8_t)s_fbRender);
 
-#else  /* DEMO_USE_ROTATE */
-    SCB_CleanInvalidateDCache_by_Addr(color_p, DEMO_FB_SIZE);
+#if DEMO_USE_ASYNC_FLUSH
+    /* Without a free frame buffer LVGL is informed in DEMO_BufferSwitchOffCallback. */
+    uint32_t primask = DisableGlobalIRQ();
+    int8_t index     = DEMO_TakeFrameBuffer();
 
-    g_dc.ops->setFrameBuffer(&g_dc, 0, (void *)color_p);
+    if (index < 0)
+    {
+        s_renderStalls++;
+        s_flushingDispDrv = disp_drv;
+    }
 
-    DEMO_WaitBufferSwitchOff();
+    EnableGlobalIRQ(primask);
+
+    if (index >= 0)
+    {
+        DEMO_SetDrawBuffer(disp_drv, (uint8_t)index);
+
+        /* IMPORTANT!!!
+         * Inform the graphics library that you are ready with the flushing*/
+        lv_disp_flush_ready(disp_drv);
+    }
+#else
+    DEMO_SetDrawBuffer(disp_drv, DEMO_AcquireFrameBuffer());
 
     /* IMPORTANT!!!
      * Inform the graphics library that you are ready with the flushing*/
     lv_disp_flush_ready(disp_drv);
-#endif /* DEMO_USE_ROTATE */
+#endif
+#endif /* DEMO_USE_ROTATE_PASS */
 }
 
 void lv_port_indev_init(void)
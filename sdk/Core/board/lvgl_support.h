@@ -22,6 +22,26 @@
 
 #define LV_ATTRIBUTE_LARGE_CONST __attribute__((section("AssetsData")))
 
+/* Frame buffer swap policy. */
+typedef enum _lv_port_swap_policy
+{
+    kLV_PORT_SwapFifo = 0U, /* Every rendered frame is shown, in order. */
+    kLV_PORT_SwapMailbox,   /* Only the newest rendered frame is shown, older waiting ones are dropped. */
+    kLV_PORT_SwapVsync,     /* The next frame is rendered only when the previous one is shown. */
+} lv_port_swap_policy_t;
+
+/* Frame buffer ring state. */
+typedef struct _lv_port_fb_state
+{
+    uint8_t bufferCount;          /* Frame buffers in the ring. */
+    uint8_t freeCount;            /* Frame buffers free to render. */
+    uint8_t readyCount;           /* Rendered frames not shown yet. */
+    lv_port_swap_policy_t policy; /* Current swap policy. */
+    uint32_t shownFrames;         /* Frames shown by the display controller. */
+    uint32_t droppedFrames;       /* Frames dropped before shown, mailbox policy only. */
+    uint32_t renderStalls;        /* Times the rendering waited for a free frame buffer. */
+} lv_port_fb_state_t;
+
 /*******************************************************************************
  * API
  ******************************************************************************/
@@ -34,6 +54,15 @@ void lv_port_pre_init(void);
 void lv_port_disp_init(void);
 void lv_port_indev_init(void);
 
+/* Bytes of D-cache cleaned and invalidated by the display port in the last frame. */
+uint32_t lv_port_get_dcache_clean_bytes(void);
+
+/* Set the frame buffer swap policy, it takes effect from the next frame. */
+void lv_port_set_swap_policy(lv_port_swap_policy_t policy);
+
+/* Get the frame buffer ring state. */
+void lv_port_get_fb_state(lv_port_fb_state_t *state);
+
 #if defined(__cplusplus)
 }
 #endif
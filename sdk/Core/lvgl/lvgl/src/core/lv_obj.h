@@ -176,6 +176,9 @@ typedef struct _lv_obj_t {
     struct _lv_obj_t * parent;
     _lv_obj_spec_attr_t * spec_attr;
     _lv_obj_style_t * styles;
+#if LV_OBJ_STYLE_CACHE_SIZE > 0
+    _lv_obj_style_cache_t * style_cache;    /**< Resolved style properties, allocated on the first read*/
+#endif
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
@@ -367,6 +370,16 @@ const lv_obj_class_t * lv_obj_get_class(const lv_obj_t * obj);
  */
 bool lv_obj_is_valid(const lv_obj_t * obj);
 
+/**
+ * Draw the main part of an object like the base class does, but on the given area instead of its coordinates.
+ * On `LV_EVENT_DRAW_MAIN` the background, border, outline, shadow and clip corner mask are drawn,
+ * on `LV_EVENT_DRAW_POST` the scrollbars and the post border.
+ * @param obj       pointer to an object
+ * @param e         the `LV_EVENT_DRAW_MAIN` or `LV_EVENT_DRAW_POST` event
+ * @param coords    the area to draw on, e.g. a transformed area of the object
+ */
+void lv_obj_draw_main_on(lv_obj_t * obj, lv_event_t * e, const lv_area_t * coords);
+
 /**
  * Scale the given number of pixels (a distance or size) relative to a 160 DPI display
  * considering the DPI of the `obj`'s display.
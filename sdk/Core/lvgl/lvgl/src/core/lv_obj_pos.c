@@ -10,6 +10,7 @@
 #include "lv_disp.h"
 #include "lv_refr.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -312,8 +313,10 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     /*Repeat until there where layout invalidations*/
     while(scr->scr_layout_inv) {
         LV_LOG_INFO("Layout update begin");
+        LV_PROFILER_BEGIN_TAG("layout");
         scr->scr_layout_inv = 0;
         layout_update_core(scr);
+        LV_PROFILER_END_TAG("layout");
         LV_LOG_TRACE("Layout update end");
     }
 
@@ -52,6 +52,7 @@ typedef struct _lv_draw_layer_ctx_t {
         const lv_area_t * clip_area;
         lv_area_t * buf_area;
         void * buf;
+        bool buf_rot_270;
         bool screen_transp;
     } original;
 } lv_draw_layer_ctx_t;
@@ -67,6 +68,14 @@ typedef struct _lv_draw_ctx_t  {
      */
     lv_area_t * buf_area;
 
+    /**
+     * `buf` is stored rotated by 270 degrees, e.g. to be scanned out directly by a rotated display.
+     * The pixel (x;y) of `buf_area` (relative coordinates) is at `buf[(w - 1 - x) * h + y]`
+     * where `w` and `h` are the width and height of `buf_area`.
+     * Only supported by the software draw context.
+     */
+    bool buf_rot_270;
+
     /**
      * The current clip area with absolute coordinates, always the same or smaller than `buf_area`
      */
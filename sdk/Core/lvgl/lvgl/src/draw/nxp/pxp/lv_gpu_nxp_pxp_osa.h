@@ -51,6 +51,9 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** Callback called from the PXP interrupt when a job is completed*/
+typedef void (*lv_gpu_nxp_pxp_complete_cb_t)(void * user_data);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -65,6 +68,30 @@ void PXP_IRQHandler(void);
  */
 lv_nxp_pxp_cfg_t * lv_gpu_nxp_pxp_get_cfg(void);
 
+/**
+ * Set a callback called from the PXP interrupt when the next started PXP job is completed.
+ * The callback is used only once, it has to be set again before every asynchronous job.
+ *
+ * @param[in] complete_cb Callback, NULL to clear a callback not used yet
+ * @param[in] user_data User data passed to the callback
+ */
+void lv_gpu_nxp_pxp_set_complete_cb(lv_gpu_nxp_pxp_complete_cb_t complete_cb, void * user_data);
+
+/**
+ * Reserve the PXP to configure and start a job. Waits while the job of another task is configured or running.
+ * The PXP is released in the interrupt when the started job completes. LVGL takes it in lv_gpu_nxp_pxp_reset().
+ */
+void lv_gpu_nxp_pxp_lock(void);
+
+/**
+ * Start a job configured by a task other than LVGL's, e.g. a video decoder, after lv_gpu_nxp_pxp_lock().
+ * The callback set with lv_gpu_nxp_pxp_set_complete_cb() is kept for the next job of LVGL.
+ *
+ * @param[in] complete_cb Callback called from the PXP interrupt when the job is completed
+ * @param[in] user_data User data passed to the callback
+ */
+void lv_gpu_nxp_pxp_run_async(lv_gpu_nxp_pxp_complete_cb_t complete_cb, void * user_data);
+
 /**********************
  *      MACROS
  **********************/
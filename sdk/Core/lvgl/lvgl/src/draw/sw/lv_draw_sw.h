@@ -76,6 +76,23 @@ void lv_draw_sw_buffer_copy(lv_draw_ctx_t * draw_ctx,
                             void * dest_buf, lv_coord_t dest_stride, const lv_area_t * dest_area,
                             void * src_buf, lv_coord_t src_stride, const lv_area_t * src_area);
 
+/**
+ * Rotate an image to an other buffer in cache friendly tiles.
+ * The direction of the rotation is the same as the display driver's software rotation:
+ * with `LV_DISP_ROT_90` the pixel (x;y) goes to (y;src_w - 1 - x),
+ * with `LV_DISP_ROT_270` to (src_h - 1 - y;x).
+ * @param src           pointer to the source image
+ * @param dest          pointer to the destination. Must be an other buffer, except for `LV_DISP_ROT_180`.
+ * @param src_w         width of the source image
+ * @param src_h         height of the source image
+ * @param src_stride    distance between the source rows in pixels
+ * @param dest_stride   distance between the destination rows in pixels
+ * @param rotation      rotation to apply
+ * @param px_size       size of a pixel in bytes (1, 2 or 4)
+ */
+void lv_draw_sw_rotate(const void * src, void * dest, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+                       lv_coord_t dest_stride, lv_disp_rot_t rotation, uint8_t px_size);
+
 void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area, const void * src_buf,
                           lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                           const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf);
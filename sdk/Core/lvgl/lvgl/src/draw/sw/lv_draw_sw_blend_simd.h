@@ -0,0 +1,692 @@
+/**
+ * @file lv_draw_sw_blend_simd.h
+ * Vectorized row kernels of the software blending.
+ * Each kernel handles the first pixels of a row and returns their count,
+ * the rest of the row is blended by the scalar loops of `lv_draw_sw_blend.c`.
+ * The results are the same as the scalar loops'.
+ */
+
+#ifndef LV_DRAW_SW_BLEND_SIMD_H
+#define LV_DRAW_SW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_style.h"
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The kernels reproduce `lv_color_mix`. With 16 bit colors only its RGB565 shortcut is implemented.*/
+#if LV_DRAW_SW_BLEND_SIMD && \
+    ((LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0 && LV_COLOR_MIX_ROUND_OFS == 0) || \
+     (LV_COLOR_DEPTH == 32 && LV_COLOR_MIX_ROUND_OFS <= 128))
+    #if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_FEATURE_MVE))
+        /*GCC/Clang vector extensions, mapped to SSE2/AVX2, NEON or Helium by the compiler*/
+        #define _BLEND_SIMD_VECTOR  1
+        #if defined(__AVX2__)
+            #define _BLEND_SIMD_BYTES   32
+        #else
+            #define _BLEND_SIMD_BYTES   16
+        #endif
+    #else
+        /*No vector unit: blend the channels of a pixel in the parts of a 32 bit register*/
+        #define _BLEND_SIMD_SWAR    1
+    #endif
+#endif
+
+#ifndef _BLEND_SIMD_VECTOR
+#define _BLEND_SIMD_VECTOR  0
+#endif
+
+#ifndef _BLEND_SIMD_SWAR
+#define _BLEND_SIMD_SWAR    0
+#endif
+
+#if _BLEND_SIMD_VECTOR
+/*Number of pixels blended at once*/
+#define _BLEND_SIMD_PX_CNT  (_BLEND_SIMD_BYTES / (int32_t)sizeof(lv_color_t))
+#endif
+
+/*The SIMD instructions of the Cortex-M DSP extension*/
+#if _BLEND_SIMD_SWAR && defined(__ARM_FEATURE_DSP) && defined(__ARM_FEATURE_SIMD32)
+#define _BLEND_SWAR_DSP     1
+#else
+#define _BLEND_SWAR_DSP     0
+#endif
+
+#if _BLEND_SWAR_DSP
+#include <arm_acle.h>
+/*Bytes 0 and 2, and bytes 1 and 3 of a word in two 16 bit halves*/
+#define _BLEND_SWAR_02(x)   __uxtb16(x)
+#define _BLEND_SWAR_13(x)   __uxtb16(__ror(x, 8))
+#elif _BLEND_SIMD_SWAR
+#define _BLEND_SWAR_02(x)   ((x) & 0x00FF00FFU)
+#define _BLEND_SWAR_13(x)   (((x) >> 8) & 0x00FF00FFU)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if _BLEND_SIMD_VECTOR
+typedef uint8_t blend_simd_mask_t __attribute__((vector_size(_BLEND_SIMD_PX_CNT)));
+typedef uint8_t blend_simd_u8_t __attribute__((vector_size(_BLEND_SIMD_BYTES)));
+typedef uint16_t blend_simd_u16_t __attribute__((vector_size(_BLEND_SIMD_BYTES)));
+#if LV_COLOR_DEPTH == 16
+typedef int16_t blend_simd_i16_t __attribute__((vector_size(_BLEND_SIMD_BYTES)));
+/*One pixel or one opacity per lane*/
+typedef uint16_t blend_simd_px_t __attribute__((vector_size(_BLEND_SIMD_BYTES)));
+#else
+typedef uint32_t blend_simd_px_t __attribute__((vector_size(_BLEND_SIMD_BYTES)));
+#endif
+#endif
+
+/**********************
+ *  STATIC FUNCTIONS
+ **********************/
+#if _BLEND_SIMD_VECTOR
+
+/**
+ * Divide by 255 like `LV_UDIV255` in 16 bit lanes. Exact up to 65279.
+ */
+static inline blend_simd_u16_t blend_simd_udiv255(blend_simd_u16_t x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+static inline blend_simd_px_t blend_simd_select(blend_simd_px_t sel, blend_simd_px_t a, blend_simd_px_t b)
+{
+    return (a & sel) | (b & ~sel);
+}
+
+static inline blend_simd_px_t blend_simd_load_mask(const lv_opa_t * mask)
+{
+    blend_simd_mask_t m;
+    __builtin_memcpy(&m, mask, sizeof(m));
+    return __builtin_convertvector(m, blend_simd_px_t);
+}
+
+#if LV_COLOR_DEPTH == 32
+/**
+ * Tell which lanes `fill_normal` leaves as they are with a mask only.
+ * It skips 4 transparent mask values read at once, but a transparent pixel next to visible ones is mixed
+ * like them, setting its alpha to 0xFF.
+ * @param mask  the mask values of the lanes from a 4 byte aligned address
+ * @return      all bits set in the skipped lanes
+ */
+static inline blend_simd_px_t blend_simd_fill_skipped(const lv_opa_t * mask)
+{
+    uint32_t mask32[_BLEND_SIMD_PX_CNT / 4];
+    __builtin_memcpy(mask32, mask, sizeof(mask32));
+
+    blend_simd_px_t skipped;
+    int32_t i;
+    for(i = 0; i < _BLEND_SIMD_PX_CNT; i++) skipped[i] = mask32[i / 4] == 0 ? 0xFFFFFFFF : 0;
+    return skipped;
+}
+#endif
+
+/**
+ * Same as `lv_color_mix(fg, bg, mix)` on each lane.
+ */
+static inline blend_simd_px_t blend_simd_mix(blend_simd_px_t fg, blend_simd_px_t bg, blend_simd_px_t mix)
+{
+#if LV_COLOR_DEPTH == 16
+    /*The RGB565 shortcut of `lv_color_mix` with the channels in separate lanes*/
+    blend_simd_i16_t m = (blend_simd_i16_t)((mix + 4) >> 3);
+    blend_simd_i16_t fr = (blend_simd_i16_t)(fg >> 11);
+    blend_simd_i16_t fg6 = (blend_simd_i16_t)((fg >> 5) & 0x3F);
+    blend_simd_i16_t fb = (blend_simd_i16_t)(fg & 0x1F);
+    blend_simd_i16_t br = (blend_simd_i16_t)(bg >> 11);
+    blend_simd_i16_t bg6 = (blend_simd_i16_t)((bg >> 5) & 0x3F);
+    blend_simd_i16_t bb = (blend_simd_i16_t)(bg & 0x1F);
+
+    blend_simd_i16_t r = br + (((fr - br) * m) >> 5);
+    blend_simd_i16_t g = bg6 + (((fg6 - bg6) * m) >> 5);
+    blend_simd_i16_t b = bb + (((fb - bb) * m) >> 5);
+
+    return ((blend_simd_px_t)r << 11) | ((blend_simd_px_t)g << 5) | (blend_simd_px_t)b;
+#else
+    /*Blue/red and green/alpha in the two halves of the lanes*/
+    blend_simd_u16_t m = (blend_simd_u16_t)(mix | (mix << 16));
+    blend_simd_u16_t m_inv = 255 - m;
+    blend_simd_u16_t rb = (blend_simd_u16_t)(fg & 0x00FF00FF) * m + (blend_simd_u16_t)(bg & 0x00FF00FF) * m_inv;
+    blend_simd_u16_t ga = (blend_simd_u16_t)((fg >> 8) & 0x00FF00FF) * m +
+                          (blend_simd_u16_t)((bg >> 8) & 0x00FF00FF) * m_inv;
+    rb = blend_simd_udiv255(rb + LV_COLOR_MIX_ROUND_OFS);
+    ga = blend_simd_udiv255(ga + LV_COLOR_MIX_ROUND_OFS);
+
+    return (blend_simd_px_t)rb | ((blend_simd_px_t)ga << 8) | 0xFF000000;
+#endif
+}
+
+/**
+ * Same as `color_blend_true_color_additive/subtractive/multiply(fg, bg, LV_OPA_COVER)` on each lane.
+ */
+static inline blend_simd_px_t blend_simd_color_blend(blend_simd_px_t fg, blend_simd_px_t bg,
+                                                     lv_blend_mode_t blend_mode)
+{
+#if LV_COLOR_DEPTH == 16
+    blend_simd_px_t fr = fg >> 11;
+    blend_simd_px_t fg6 = (fg >> 5) & 0x3F;
+    blend_simd_px_t fb = fg & 0x1F;
+    blend_simd_px_t br = bg >> 11;
+    blend_simd_px_t bg6 = (bg >> 5) & 0x3F;
+    blend_simd_px_t bb = bg & 0x1F;
+    blend_simd_px_t r;
+    blend_simd_px_t g;
+    blend_simd_px_t b;
+
+    switch(blend_mode) {
+        case LV_BLEND_MODE_ADDITIVE:
+            r = fr + br;
+            g = fg6 + bg6;
+            b = fb + bb;
+            r ^= (r ^ 31) & (blend_simd_px_t)(r > 31);
+            g ^= (g ^ 63) & (blend_simd_px_t)(g > 63);
+            b ^= (b ^ 31) & (blend_simd_px_t)(b > 31);
+            break;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            r = (br - fr) & (blend_simd_px_t)(br >= fr);
+            g = (bg6 - fg6) & (blend_simd_px_t)(bg6 >= fg6);
+            b = (bb - fb) & (blend_simd_px_t)(bb >= fb);
+            break;
+        default:
+            r = (fr * br) >> 5;
+            g = (fg6 * bg6) >> 6;
+            b = (fb * bb) >> 5;
+            break;
+    }
+
+    return (r << 11) | (g << 5) | b;
+#else
+    blend_simd_u8_t f8 = (blend_simd_u8_t)fg;
+    blend_simd_u8_t b8 = (blend_simd_u8_t)bg;
+    blend_simd_px_t res;
+
+    switch(blend_mode) {
+        case LV_BLEND_MODE_ADDITIVE: {
+                blend_simd_u8_t sum = f8 + b8;
+                res = (blend_simd_px_t)(sum | (blend_simd_u8_t)(sum < f8));
+                break;
+            }
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            res = (blend_simd_px_t)((b8 - f8) & (blend_simd_u8_t)(b8 >= f8));
+            break;
+        default: {
+                /*Blue/red and green/alpha in the two halves of the lanes*/
+                blend_simd_u16_t rb = ((blend_simd_u16_t)(fg & 0x00FF00FF) * (blend_simd_u16_t)(bg & 0x00FF00FF)) >> 8;
+                blend_simd_u16_t ga = ((blend_simd_u16_t)((fg >> 8) & 0x00FF00FF) *
+                                       (blend_simd_u16_t)((bg >> 8) & 0x00FF00FF)) >> 8;
+                res = (blend_simd_px_t)rb | ((blend_simd_px_t)ga << 8);
+                break;
+            }
+    }
+
+    /*The alpha channel is the foreground's*/
+    return (res & 0x00FFFFFF) | (fg & 0xFF000000);
+#endif
+}
+
+/**
+ * Blend a color or an image to the first pixels of a row.
+ * @param dest_buf  the row of the destination
+ * @param color     the color to fill with if `src_buf == NULL`
+ * @param src_buf   the row of the image or NULL
+ * @param mask      the row of the mask or NULL. 4 byte aligned to fill with `mask_only`.
+ * @param opa       the opacity to blend with
+ * @param mask_only true: ignore `opa`; false: scale the mask values with `opa`
+ * @param mask_full the smallest mask value used as `opa` as it is
+ * @param w         width of the row
+ * @return          the number of pixels blended
+ */
+static inline int32_t blend_simd_row(lv_color_t * dest_buf, lv_color_t color, const lv_color_t * src_buf,
+                                     const lv_opa_t * mask, lv_opa_t opa, bool mask_only, lv_opa_t mask_full,
+                                     int32_t w)
+{
+    blend_simd_px_t fg = {0};
+    blend_simd_px_t opa_v = {0};
+    opa_v += opa;
+    if(src_buf == NULL) fg += color.full;
+
+    int32_t x;
+    for(x = 0; x <= w - _BLEND_SIMD_PX_CNT; x += _BLEND_SIMD_PX_CNT) {
+        blend_simd_px_t bg;
+        blend_simd_px_t mask_v = {0};
+        blend_simd_px_t m;
+        blend_simd_px_t res;
+
+        if(src_buf) __builtin_memcpy(&fg, src_buf + x, sizeof(fg));
+
+        if(mask == NULL) {
+            m = opa_v;
+        }
+        else {
+            mask_v = blend_simd_load_mask(mask + x);
+            if(mask_only) m = mask_v;
+            else m = blend_simd_select((blend_simd_px_t)(mask_v >= mask_full), opa_v, (mask_v * opa) >> 8);
+        }
+
+        __builtin_memcpy(&bg, dest_buf + x, sizeof(bg));
+        res = blend_simd_mix(fg, bg, m);
+
+        /*Full cover copies the color as it is and a transparent mask keeps the destination*/
+        res = blend_simd_select((blend_simd_px_t)(m == LV_OPA_COVER), fg, res);
+        if(mask) {
+            blend_simd_px_t keep = (blend_simd_px_t)(mask_v == LV_OPA_TRANSP);
+#if LV_COLOR_DEPTH == 32
+            if(src_buf == NULL && mask_only) keep &= blend_simd_fill_skipped(mask + x);
+#endif
+            res = blend_simd_select(keep, bg, res);
+        }
+
+        __builtin_memcpy(dest_buf + x, &res, sizeof(res));
+    }
+
+    return x;
+}
+
+#elif _BLEND_SIMD_SWAR
+
+/**
+ * Add the bytes of two words, saturating at 255 like `__uqadd8`.
+ */
+static inline uint32_t blend_swar_add_sat(uint32_t a, uint32_t b)
+{
+#if _BLEND_SWAR_DSP
+    return __uqadd8(a, b);
+#else
+    /*Add the low 7 bits, then the top bits and get the carries from them*/
+    uint32_t sum = (a & 0x7F7F7F7FU) + (b & 0x7F7F7F7FU);
+    uint32_t carry = ((a & b) | ((a | b) & sum)) & 0x80808080U;
+    sum ^= (a ^ b) & 0x80808080U;
+    return sum | ((carry >> 7) * 0xFFU);
+#endif
+}
+
+/**
+ * Subtract the bytes of `b` from the bytes of `a`, saturating at 0 like `__uqsub8`.
+ */
+static inline uint32_t blend_swar_sub_sat(uint32_t a, uint32_t b)
+{
+#if _BLEND_SWAR_DSP
+    return __uqsub8(a, b);
+#else
+    /*Subtract the low 7 bits from a set top bit so the bytes don't borrow from each other*/
+    uint32_t diff = (a | 0x80808080U) - (b & 0x7F7F7F7FU);
+    uint32_t borrow = ((~a & b) | (~(a ^ b) & ~diff)) & 0x80808080U;
+    diff ^= ~(a ^ b) & 0x80808080U;
+    return diff & ~((borrow >> 7) * 0xFFU);
+#endif
+}
+
+#if LV_COLOR_DEPTH == 16
+/*The channels of an RGB565 color on the top of the bytes of a word, so they saturate at their maximum*/
+static inline uint32_t blend_swar_565_to_bytes(uint32_t c)
+{
+    return ((c & 0x001FU) << 3) | ((c & 0x07E0U) << 5) | ((c & 0xF800U) << 8);
+}
+
+static inline uint32_t blend_swar_bytes_to_565(uint32_t c)
+{
+    return ((c >> 3) & 0x001FU) | ((c >> 5) & 0x07E0U) | ((c >> 8) & 0xF800U);
+}
+#endif
+
+/**
+ * Same as `color_blend_true_color_additive/subtractive/multiply(fg, bg, LV_OPA_COVER)`.
+ */
+static inline uint32_t blend_swar_color_blend(uint32_t fg, uint32_t bg, lv_blend_mode_t blend_mode)
+{
+#if LV_COLOR_DEPTH == 16
+    switch(blend_mode) {
+        case LV_BLEND_MODE_ADDITIVE:
+            return blend_swar_bytes_to_565(blend_swar_add_sat(blend_swar_565_to_bytes(fg), blend_swar_565_to_bytes(bg)));
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            return blend_swar_bytes_to_565(blend_swar_sub_sat(blend_swar_565_to_bytes(bg), blend_swar_565_to_bytes(fg)));
+        default:
+            return ((((fg >> 11) * (bg >> 11)) >> 5) << 11) |
+                   (((((fg >> 5) & 0x3FU) * ((bg >> 5) & 0x3FU)) >> 6) << 5) |
+                   (((fg & 0x1FU) * (bg & 0x1FU)) >> 5);
+    }
+#else
+    uint32_t res;
+    switch(blend_mode) {
+        case LV_BLEND_MODE_ADDITIVE:
+            res = blend_swar_add_sat(fg, bg);
+            break;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            res = blend_swar_sub_sat(bg, fg);
+            break;
+        default:
+            res = (((fg & 0xFFU) * (bg & 0xFFU)) >> 8) |
+                  (((((fg >> 8) & 0xFFU) * ((bg >> 8) & 0xFFU)) >> 8) << 8) |
+                  (((((fg >> 16) & 0xFFU) * ((bg >> 16) & 0xFFU)) >> 8) << 16);
+            break;
+    }
+
+    /*The alpha channel is the foreground's*/
+    return (res & 0x00FFFFFFU) | (fg & 0xFF000000U);
+#endif
+}
+
+/**
+ * Same as `lv_color_mix(fg, bg, mix)`.
+ */
+static inline uint32_t blend_swar_mix(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+#if LV_COLOR_DEPTH == 16
+    /*The RGB565 shortcut of `lv_color_mix` already mixes all the channels with one multiplication*/
+    lv_color_t fg_color;
+    lv_color_t bg_color;
+    fg_color.full = fg;
+    bg_color.full = bg;
+    return lv_color_mix(fg_color, bg_color, mix).full;
+#else
+    uint32_t mix_inv = 255 - mix;
+    uint32_t rb = _BLEND_SWAR_02(fg) * mix + _BLEND_SWAR_02(bg) * mix_inv + LV_COLOR_MIX_ROUND_OFS * 0x00010001U;
+    uint32_t ga = _BLEND_SWAR_13(fg) * mix + _BLEND_SWAR_13(bg) * mix_inv + LV_COLOR_MIX_ROUND_OFS * 0x00010001U;
+
+    /*`LV_UDIV255` on both halves*/
+    rb = ((rb + 0x00010001U + _BLEND_SWAR_13(rb)) >> 8) & 0x00FF00FFU;
+    ga = ((ga + 0x00010001U + _BLEND_SWAR_13(ga)) >> 8) & 0x00FF00FFU;
+
+    return rb | (ga << 8) | 0xFF000000U;
+#endif
+}
+
+#if LV_COLOR_DEPTH == 32
+
+/**
+ * Tell if `fill_normal` leaves a pixel as it is with a mask only. See `blend_simd_fill_skipped`.
+ * @param mask  the row of the mask from a 4 byte aligned address
+ * @param x     index of a pixel with transparent mask
+ * @param w     width of the row
+ * @return      true: the pixel is skipped; false: it's mixed with 0 opacity
+ */
+static inline bool blend_swar_fill_skipped(const lv_opa_t * mask, int32_t x, int32_t w)
+{
+    int32_t x4 = x & ~3;
+    if(x4 + 4 > w) return false;
+
+    uint32_t mask32;
+    __builtin_memcpy(&mask32, mask + x4, sizeof(mask32));
+    return mask32 == 0;
+}
+
+static inline int32_t blend_simd_row(lv_color_t * dest_buf, lv_color_t color, const lv_color_t * src_buf,
+                                     const lv_opa_t * mask, lv_opa_t opa, bool mask_only, lv_opa_t mask_full,
+                                     int32_t w)
+{
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_opa_t m;
+        if(mask == NULL) {
+            m = opa;
+        }
+        else {
+            m = mask[x];
+            if(m == LV_OPA_TRANSP && (src_buf || !mask_only || blend_swar_fill_skipped(mask, x, w))) continue;
+            if(!mask_only) m = m >= mask_full ? opa : (uint32_t)((uint32_t)m * opa) >> 8;
+        }
+
+        lv_color_t fg = src_buf ? src_buf[x] : color;
+        if(m == LV_OPA_COVER) dest_buf[x] = fg;
+        else dest_buf[x].full = blend_swar_mix(fg.full, dest_buf[x].full, m);
+    }
+
+    return x;
+}
+#endif /*LV_COLOR_DEPTH == 32*/
+
+#endif /*_BLEND_SIMD_SWAR*/
+
+/**
+ * Fill the first pixels of a row with a color premultiplied by `lv_color_premult`,
+ * like `lv_color_mix_premult(color_premult, dest_buf[x], opa_inv)`.
+ * Not vectorized with SWAR, caching the last result is faster there.
+ * @return the number of pixels filled
+ */
+static inline int32_t blend_simd_fill_premult(lv_color_t * dest_buf, const uint16_t * color_premult, lv_opa_t opa_inv,
+                                              int32_t w)
+{
+#if _BLEND_SIMD_VECTOR
+#if LV_COLOR_DEPTH == 16
+    blend_simd_u16_t pr = {0};
+    blend_simd_u16_t pg = {0};
+    blend_simd_u16_t pb = {0};
+    pr += color_premult[0];
+    pg += color_premult[1];
+    pb += color_premult[2];
+#else
+    /*Blue/red and green in the halves of the lanes*/
+    blend_simd_px_t prb = {0};
+    blend_simd_px_t pg = {0};
+    prb += color_premult[2] | ((uint32_t)color_premult[0] << 16);
+    pg += color_premult[1];
+#endif
+
+    int32_t x;
+    for(x = 0; x <= w - _BLEND_SIMD_PX_CNT; x += _BLEND_SIMD_PX_CNT) {
+        blend_simd_px_t bg;
+        __builtin_memcpy(&bg, dest_buf + x, sizeof(bg));
+#if LV_COLOR_DEPTH == 16
+        blend_simd_u16_t r = blend_simd_udiv255(pr + (bg >> 11) * opa_inv);
+        blend_simd_u16_t g = blend_simd_udiv255(pg + ((bg >> 5) & 0x3F) * opa_inv);
+        blend_simd_u16_t b = blend_simd_udiv255(pb + (bg & 0x1F) * opa_inv);
+        blend_simd_px_t res = (r << 11) | (g << 5) | b;
+#else
+        blend_simd_u16_t rb = (blend_simd_u16_t)(bg & 0x00FF00FF) * opa_inv + (blend_simd_u16_t)prb +
+                              LV_COLOR_MIX_ROUND_OFS;
+        blend_simd_u16_t g = (blend_simd_u16_t)((bg >> 8) & 0x000000FF) * opa_inv + (blend_simd_u16_t)pg +
+                             LV_COLOR_MIX_ROUND_OFS;
+        blend_simd_px_t res = (blend_simd_px_t)blend_simd_udiv255(rb) |
+                              ((blend_simd_px_t)blend_simd_udiv255(g) << 8) | 0xFF000000;
+#endif
+        __builtin_memcpy(dest_buf + x, &res, sizeof(res));
+    }
+
+    return x;
+#else
+    LV_UNUSED(dest_buf);
+    LV_UNUSED(color_premult);
+    LV_UNUSED(opa_inv);
+    LV_UNUSED(w);
+    return 0;
+#endif
+}
+
+/**
+ * Fill the first pixels of a row with a color like `fill_normal` with a mask.
+ * @param mask  the row of the mask, 4 byte aligned if `opa >= LV_OPA_MAX`
+ * @param opa   >= LV_OPA_MAX: only the mask matters; else the mask is scaled with `opa`
+ * @return      the number of pixels filled
+ */
+static inline int32_t blend_simd_fill_mask(lv_color_t * dest_buf, lv_color_t color, const lv_opa_t * mask,
+                                           lv_opa_t opa, int32_t w)
+{
+#if _BLEND_SIMD_VECTOR || (_BLEND_SIMD_SWAR && LV_COLOR_DEPTH == 32)
+    return blend_simd_row(dest_buf, color, NULL, mask, opa, opa >= LV_OPA_MAX, LV_OPA_COVER, w);
+#else
+    LV_UNUSED(dest_buf);
+    LV_UNUSED(color);
+    LV_UNUSED(mask);
+    LV_UNUSED(opa);
+    LV_UNUSED(w);
+    return 0;
+#endif
+}
+
+/**
+ * Blend the first pixels of an image row like `map_normal`.
+ * @param mask  the row of the mask or NULL
+ * @param opa   the opacity, with a mask > LV_OPA_MAX means only the mask matters
+ * @return      the number of pixels blended
+ */
+static inline int32_t blend_simd_map(lv_color_t * dest_buf, const lv_color_t * src_buf, const lv_opa_t * mask,
+                                     lv_opa_t opa, int32_t w)
+{
+#if _BLEND_SIMD_VECTOR || (_BLEND_SIMD_SWAR && LV_COLOR_DEPTH == 32)
+    return blend_simd_row(dest_buf, lv_color_black(), src_buf, mask, opa, opa > LV_OPA_MAX, LV_OPA_MAX, w);
+#else
+    LV_UNUSED(dest_buf);
+    LV_UNUSED(src_buf);
+    LV_UNUSED(mask);
+    LV_UNUSED(opa);
+    LV_UNUSED(w);
+    return 0;
+#endif
+}
+
+/**
+ * Fill the first pixels of a row with a color like `fill_blended`.
+ * @param mask          the row of the mask or NULL
+ * @param opa           the opacity, scaled by the mask values below LV_OPA_MAX
+ * @param blend_mode    LV_BLEND_MODE_ADDITIVE/SUBTRACTIVE/MULTIPLY
+ * @return              the number of pixels filled
+ */
+static inline int32_t blend_simd_fill_blended(lv_color_t * dest_buf, lv_color_t color, const lv_opa_t * mask,
+                                              lv_opa_t opa, lv_blend_mode_t blend_mode, int32_t w)
+{
+#if _BLEND_SIMD_VECTOR
+    blend_simd_px_t fg = {0};
+    blend_simd_px_t opa_v = {0};
+    fg += color.full;
+    opa_v += opa;
+
+    int32_t x;
+    for(x = 0; x <= w - _BLEND_SIMD_PX_CNT; x += _BLEND_SIMD_PX_CNT) {
+        blend_simd_px_t bg;
+        blend_simd_px_t m = opa_v;
+        if(mask) {
+            blend_simd_px_t mask_v = blend_simd_load_mask(mask + x);
+            m = blend_simd_select((blend_simd_px_t)(mask_v >= LV_OPA_MAX), opa_v, (mask_v * opa) >> 8);
+        }
+
+        __builtin_memcpy(&bg, dest_buf + x, sizeof(bg));
+        blend_simd_px_t blended = blend_simd_color_blend(fg, bg, blend_mode);
+        blend_simd_px_t res = blend_simd_select((blend_simd_px_t)(m == LV_OPA_COVER), blended,
+                                                blend_simd_mix(blended, bg, m));
+        /*A transparent mask keeps the destination too*/
+        res = blend_simd_select((blend_simd_px_t)(m <= LV_OPA_MIN), bg, res);
+
+        __builtin_memcpy(dest_buf + x, &res, sizeof(res));
+    }
+
+    return x;
+#elif _BLEND_SIMD_SWAR
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        lv_opa_t m = opa;
+        if(mask) m = mask[x] >= LV_OPA_MAX ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+        if(m <= LV_OPA_MIN) continue;
+
+        uint32_t res = blend_swar_color_blend(color.full, dest_buf[x].full, blend_mode);
+        if(m != LV_OPA_COVER) res = blend_swar_mix(res, dest_buf[x].full, m);
+        dest_buf[x].full = res;
+    }
+
+    return x;
+#else
+    LV_UNUSED(dest_buf);
+    LV_UNUSED(color);
+    LV_UNUSED(mask);
+    LV_UNUSED(opa);
+    LV_UNUSED(blend_mode);
+    LV_UNUSED(w);
+    return 0;
+#endif
+}
+
+/**
+ * Blend the first pixels of an image row to an ARGB buffer like `map_argb` with normal blending.
+ * Only 32 bit colors are vectorized.
+ * @param dest_buf8 the row of the destination
+ * @param mask      the row of the mask or NULL
+ * @param opa       the opacity of the image
+ * @param mask_only true: use the mask values as opacity; false: scale them with `opa` and skip the transparent ones
+ * @return          the number of pixels blended
+ */
+static inline int32_t blend_simd_map_argb(uint8_t * dest_buf8, const lv_color_t * src_buf, const lv_opa_t * mask,
+                                          lv_opa_t opa, bool mask_only, int32_t w)
+{
+#if _BLEND_SIMD_VECTOR && LV_COLOR_DEPTH == 32
+    lv_color_t * dest_buf = (lv_color_t *)dest_buf8;
+    blend_simd_px_t opa_v = {0};
+    opa_v += opa;
+
+    int32_t x;
+    for(x = 0; x <= w - _BLEND_SIMD_PX_CNT; x += _BLEND_SIMD_PX_CNT) {
+        blend_simd_px_t fg;
+        blend_simd_px_t bg;
+        blend_simd_px_t fg_opa = opa_v;
+        blend_simd_px_t skip = {0};
+        if(mask) {
+            blend_simd_px_t mask_v = blend_simd_load_mask(mask + x);
+            if(mask_only) {
+                fg_opa = mask_v;
+            }
+            else {
+                fg_opa = blend_simd_select((blend_simd_px_t)(mask_v >= LV_OPA_MAX), opa_v, (mask_v * opa) >> 8);
+                skip = (blend_simd_px_t)(mask_v == LV_OPA_TRANSP);
+            }
+        }
+
+        __builtin_memcpy(&fg, src_buf + x, sizeof(fg));
+        __builtin_memcpy(&bg, dest_buf + x, sizeof(bg));
+        blend_simd_px_t bg_opa = bg >> 24;
+
+        /*The cases of `lv_color_mix_with_alpha`*/
+        blend_simd_px_t pick_fg = (blend_simd_px_t)(fg_opa >= LV_OPA_MAX) | (blend_simd_px_t)(bg_opa <= LV_OPA_MIN);
+        blend_simd_px_t fg_transp = (blend_simd_px_t)(fg_opa <= LV_OPA_MIN);
+        blend_simd_px_t keep_bg = (fg_transp & ~pick_fg) | skip;
+        blend_simd_px_t mix_bg = (blend_simd_px_t)(bg_opa >= LV_OPA_MAX) & ~pick_fg & ~keep_bg;
+
+        /*A transparent result sets only the alpha*/
+        blend_simd_px_t res_fg = (blend_simd_select(fg_transp, bg, fg) & 0x00FFFFFF) | (fg_opa << 24);
+        blend_simd_px_t res = blend_simd_select(mix_bg, blend_simd_mix(fg, bg, fg_opa), bg);
+        res = blend_simd_select(pick_fg & ~skip, res_fg, res);
+        __builtin_memcpy(dest_buf + x, &res, sizeof(res));
+
+        /*Both colors have alpha: let `lv_color_mix_with_alpha` divide*/
+        blend_simd_px_t both_alpha = ~(pick_fg | keep_bg | mix_bg);
+        int32_t i;
+        for(i = 0; i < _BLEND_SIMD_PX_CNT; i++) {
+            if(both_alpha[i] == 0) continue;
+
+            lv_color_t fg_color;
+            lv_color_t bg_color;
+            lv_color_t res_color;
+            lv_opa_t res_opa;
+            fg_color.full = fg[i];
+            bg_color.full = bg[i];
+            lv_color_mix_with_alpha(bg_color, bg_opa[i], fg_color, fg_opa[i], &res_color, &res_opa);
+            res_color.ch.alpha = res_opa;
+            dest_buf[x + i] = res_color;
+        }
+    }
+
+    return x;
+#else
+    LV_UNUSED(dest_buf8);
+    LV_UNUSED(src_buf);
+    LV_UNUSED(mask);
+    LV_UNUSED(opa);
+    LV_UNUSED(mask_only);
+    LV_UNUSED(w);
+    return 0;
+#endif
+}
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_SIMD_H*/
@@ -83,6 +83,7 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
         draw_ctx->buf = layer_sw_ctx->base_draw.buf;
         draw_ctx->buf_area = &layer_sw_ctx->base_draw.area_act;
         draw_ctx->clip_area = &layer_sw_ctx->base_draw.area_act;
+        draw_ctx->buf_rot_270 = false;
 
         lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
         disp_refr->driver->screen_transp = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? 1 : 0;
@@ -110,6 +111,7 @@ void lv_draw_sw_layer_adjust(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_l
     draw_ctx->buf = layer_ctx->buf;
     draw_ctx->buf_area = &layer_ctx->area_act;
     draw_ctx->clip_area = &layer_ctx->area_act;
+    draw_ctx->buf_rot_270 = false;
 }
 
 void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_layer_ctx_t * layer_ctx,
@@ -128,6 +130,7 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
     draw_ctx->buf = layer_ctx->original.buf;
     draw_ctx->buf_area = layer_ctx->original.buf_area;
     draw_ctx->clip_area = layer_ctx->original.clip_area;
+    draw_ctx->buf_rot_270 = layer_ctx->original.buf_rot_270;
     lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
     disp_refr->driver->screen_transp = layer_ctx->original.screen_transp;
 
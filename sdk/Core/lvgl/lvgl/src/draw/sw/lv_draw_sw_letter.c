@@ -148,6 +148,11 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
 
     if(g.resolved_font->subpx) {
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
+        /*Sub-pixel rendering writes the buffer directly*/
+        if(draw_ctx->buf_rot_270) {
+            LV_LOG_WARN("Can't draw sub-pixel rendered letter to a rotated buffer");
+            return;
+        }
         draw_letter_subpx(draw_ctx, dsc, &gpos, &g, map_p);
 #else
         LV_LOG_WARN("Can't draw sub-pixel rendered letter because LV_USE_FONT_SUBPX == 0 in lv_conf.h");
@@ -218,9 +223,9 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static LV_THREAD_LOCAL lv_opa_t opa_table[256];
+    static LV_THREAD_LOCAL lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static LV_THREAD_LOCAL uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
@@ -8,6 +8,7 @@
  *********************/
 
 #include "lv_video.h"
+#include "lv_video_yuv.h"
 
 #if LV_USE_VIDEO != 0
 
@@ -25,22 +26,52 @@
     #include "fsl_debug_console.h"
     #include "fsl_pxp.h"
     #include "fsl_cache.h"
+    #include "semphr.h"
+    #include "../../../draw/nxp/pxp/lv_gpu_nxp_pxp_osa.h"
 #else
     #include "decoder.h"
     #include <unistd.h>
+    #include <pthread.h>
+#endif
+#if LV_VIDEO_SDL_YUV
+    #include "../../../draw/sdl/lv_draw_sdl_img.h"
 #endif
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_video_class
-#define LV_COLOR_SIZE 16
 #ifndef DEMO_FILE_BUF_SIZE
     #define DEMO_FILE_BUF_SIZE (16 * 1024)
 #endif
 #ifndef DEMO_DECODE_BUF_SIZE
     #define DEMO_DECODE_BUF_SIZE (64 * 1024)
 #endif
+#ifndef LV_VIDEO_TASK_STACK_SIZE
+    #define LV_VIDEO_TASK_STACK_SIZE (8 * 1024)
+#endif
+#ifndef LV_VIDEO_TASK_PRIORITY
+    /* Below the LVGL task to keep the UI responsive. */
+    #define LV_VIDEO_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+#endif
+
+/* The frame queue is shared by the decode thread and the LVGL timer. */
+#if LV_USE_GUIDER_SIMULATOR
+    #define VIDEO_LOCK()            pthread_mutex_lock(&s_queueMutex)
+    #define VIDEO_UNLOCK()          pthread_mutex_unlock(&s_queueMutex)
+    #define VIDEO_SLEEP_MS(ms)      usleep((ms) * 1000)
+#else
+    #define VIDEO_LOCK()            taskENTER_CRITICAL()
+    #define VIDEO_UNLOCK()          taskEXIT_CRITICAL()
+    #define VIDEO_SLEEP_MS(ms)      vTaskDelay(pdMS_TO_TICKS(ms))
+#endif
+
+#if !LV_USE_GUIDER_SIMULATOR && LV_USE_GPU_NXP_PXP && LV_USE_GPU_NXP_PXP_AUTO_INIT
+    /* The frames are converted in the background, queued with the PXP jobs of LVGL. */
+    #define VIDEO_PXP_ASYNC 1
+#else
+    #define VIDEO_PXP_ASYNC 0
+#endif
 
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
@@ -48,34 +79,70 @@
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct {
+    ISVCDecoder * dec;
+    bool used;
+} video_decoder_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
-static int16_t video_width = 0;
-static int16_t video_height = 0;
 static void lv_video_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_video_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_video_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void video_timer_cb(lv_timer_t * timer);
+static bool video_thread_create(lv_obj_t * obj);
+static void video_thread_join(lv_obj_t * obj);
+static uint8_t * frame_acquire(lv_obj_t * obj, int32_t * idx);
+#if !VIDEO_PXP_ASYNC
+static void frame_queue(lv_obj_t * obj, int32_t idx);
+#endif
+static void frame_queue_add(lv_video_t * video, int32_t idx);
+static void frame_decoded(lv_obj_t * obj, SBufferInfo * info, uint8_t ** dst);
+static uint32_t clock_get(lv_video_t * video);
+static void clock_rebase(lv_video_t * video);
+static bool overlay_get_area(lv_obj_t * obj, lv_area_t * area);
+static void overlay_update(lv_obj_t * obj);
+static bool overlay_busy(lv_video_t * video);
+static void overlay_close(lv_obj_t * obj);
+static bool nalu_skip(lv_obj_t * obj, const uint8_t * nalu, int32_t len);
+static void bs_reset(lv_video_bitstream_t * bs, uint32_t pos);
+static void bs_seek(lv_video_t * video, uint32_t pos);
+static lv_res_t bs_next_nalu(lv_video_t * video, const uint8_t ** nalu, uint32_t * len);
+static void index_scan(lv_obj_t * obj, uint32_t frame);
+static void seek_apply(lv_obj_t * obj);
+static void decode_nalu(lv_obj_t * obj, const uint8_t * nalu, uint32_t len);
+static void decode_flush(lv_obj_t * obj);
+static ISVCDecoder * decoder_acquire(void);
+static void decoder_release(ISVCDecoder * dec);
 
 #if !LV_USE_GUIDER_SIMULATOR
 /* PXP Usage */
 
-static void PXP_DisplayFrame(uint16_t width,
+static void PXP_DisplayFrame(lv_video_t * video,
+                             int32_t idx,
+                             uint16_t width,
                              uint16_t height,
                              const uint8_t * Y,
                              const uint8_t * U,
                              const uint8_t * V,
                              uint32_t Y_Stride,
                              uint32_t UV_Stride,
-                             lv_obj_t * obj);
+                             uint8_t * out);
+#if VIDEO_PXP_ASYNC
+static void pxp_complete_cb(void * param);
+static void pxp_frame_wait(lv_video_t * video);
+#endif
+static void video_task(void * param);
 #else
-static void yuv420pToRgb565(int oriWidth,
-                            int oriHeight,
-                            int width, int height,
-                            uint8_t * py, uint8_t * pu, uint8_t * pv,
-                            unsigned short * dst);
-static void CPU_DisplayFrame(SBufferInfo sDstBufInfo, unsigned char ** dst, lv_obj_t * obj);
+#if LV_VIDEO_SDL_YUV
+static void frame_copy_yuv(lv_video_t * video, int32_t idx, SBufferInfo * info, uint8_t ** dst);
+static void draw_yuv(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
+#else
+static void CPU_DisplayFrame(lv_video_t * video, SBufferInfo sDstBufInfo, unsigned char ** dst, uint8_t * out);
+#endif
+static void * video_thread(void * param);
 #endif
 /**********************
  *  STATIC VARIABLES
@@ -87,22 +154,30 @@ const lv_obj_class_t lv_video_class = {
     .height_def = LV_SIZE_CONTENT,
     .constructor_cb = lv_video_constructor,
     .destructor_cb = lv_video_destructor,
+    .event_cb = lv_video_event,
 };
 
+/* Created on first use and kept for the next videos as creating a decoder is expensive. */
+static video_decoder_t s_decoderPool[LV_VIDEO_DECODER_CNT];
+
+static const lv_video_overlay_t * s_overlay;
+
+#if LV_VIDEO_SDL_YUV
+    /* Unique among the videos, a new widget at the address of a deleted one doesn't reuse its texture. */
+    static uint32_t s_frameId;
+#endif
+
 #if !LV_USE_GUIDER_SIMULATOR
     /* PXP Usage */
-    static pxp_output_buffer_config_t s_pxpOutputBufferConfig;
-    static pxp_ps_buffer_config_t s_pxpPsBufferConfig;
-    static volatile uint8_t s_lcdActiveFbIdx = 0;
-    static int buffer_byte_per_pixel = 2;
-    static uint8_t * s_lcdBuffer[2];
+    static int buffer_byte_per_pixel = sizeof(lv_color_t);
+    #if !VIDEO_PXP_ASYNC
+        /* The decode tasks of the videos share the PXP. */
+        static SemaphoreHandle_t s_pxpMutex;
+    #endif
 #else
-    static int mallocInit = 0;
-    static uint8_t * rgb, *py, *pu, *pv;
+    static pthread_mutex_t s_queueMutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
-static uint8_t s_decodeBuf[DEMO_DECODE_BUF_SIZE];
-
 /**********************
  *      MACROS
  **********************/
@@ -120,15 +195,10 @@ lv_obj_t * lv_video_create(lv_obj_t * parent, int widgetWidth, int widgetHeight)
 {
     LV_LOG_INFO("begin");
 
-    video_width = widgetWidth;
-    video_height = widgetHeight;
-
-#if !LV_USE_GUIDER_SIMULATOR
-    s_lcdBuffer[0] = malloc(widgetWidth * widgetHeight * buffer_byte_per_pixel);
-    s_lcdBuffer[1] = malloc(widgetWidth * widgetHeight * buffer_byte_per_pixel);
-#endif
-
     lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    /* The constructor allocates the frames with this size. */
+    ((lv_video_t *)obj)->video_w = widgetWidth;
+    ((lv_video_t *)obj)->video_h = widgetHeight;
     lv_obj_class_init_obj(obj);
     return obj;
 }
@@ -136,200 +206,338 @@ lv_obj_t * lv_video_create(lv_obj_t * parent, int widgetWidth, int widgetHeight)
 void lv_video_play(lv_obj_t * obj)
 {
     lv_video_t * video = (lv_video_t *)obj;
-    Read_HFile(video->file_name, obj);
-}
 
-static int search_nalu(const uint8_t * data, int32_t len)
-{
-    int i;
-    /* parse NALU 00 00 00 01 or 00 00 01 */
-    for(i = 1; i < len - 4; i++) {
-        if((data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 0 && data[i + 3] == 1) ||
-           (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)) {
-            return i;
-        }
+    /* Already playing. */
+    if(video->thread != NULL) return;
+
+#if !LV_USE_GUIDER_SIMULATOR && !VIDEO_PXP_ASYNC
+    if(s_pxpMutex == NULL) s_pxpMutex = xSemaphoreCreateMutex();
+#endif
+
+    video->decoder = decoder_acquire();
+    if(video->decoder == NULL) {
+        LV_LOG_WARN("all the %d decoders are in use", LV_VIDEO_DECODER_CNT);
+        return;
     }
 
-    if(data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
-        return i;
+    /* Open the file here as the file system drivers might allocate from the LVGL heap. */
+    if(lv_fs_open(&video->h264File, video->file_name, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("can't open %s", video->file_name);
+        decoder_release(video->decoder);
+        video->decoder = NULL;
+        return;
     }
 
-    return -1;
+    /* A saved index spares the scanning of the file when seeking. */
+    if(video->index.cnt == 0 && !video->index.complete) {
+        char path[LV_FS_MAX_PATH_LENGTH];
+        uint32_t file_size = 0;
+        lv_fs_seek(&video->h264File, 0, LV_FS_SEEK_END);
+        lv_fs_tell(&video->h264File, &file_size);
+        lv_fs_seek(&video->h264File, 0, LV_FS_SEEK_SET);
+        lv_snprintf(path, sizeof(path), "%s.idx", video->file_name);
+        lv_video_index_load(&video->index, path, file_size);
+    }
+
+    /* The file is read ahead in the background while the decode thread decodes. */
+    if(lv_video_reader_open(&video->reader, &video->h264File, 0) != LV_RES_OK) {
+        LV_LOG_WARN("can't start reading %s", video->file_name);
+        lv_fs_close(&video->h264File);
+        decoder_release(video->decoder);
+        video->decoder = NULL;
+        return;
+    }
+
+    /* Check the frame queue twice per frame. */
+    video->timer = lv_timer_create(video_timer_cb, LV_MAX(500 / video->fps, 1), obj);
+
+    if(!video_thread_create(obj)) {
+        LV_LOG_ERROR("can't create the decode thread");
+        lv_timer_del(video->timer);
+        video->timer = NULL;
+        lv_video_reader_close(&video->reader);
+        lv_fs_close(&video->h264File);
+        decoder_release(video->decoder);
+        video->decoder = NULL;
+        return;
+    }
+
+    /* Keep the layer until the widget is deleted, another video might take it otherwise. */
+    if(s_overlay != NULL && !video->overlay_open) {
+        video->overlay_open = s_overlay->open_cb(obj, video->video_w, video->video_h);
+    }
 }
 
-int Decoder_Data(const uint8_t * data, int len, bool isStartOfFile, bool isEndOfFile, lv_obj_t * obj)
+/**
+ * Empty the bitstream window to read the file from a position. The reader has to be seeked there.
+ * @param bs pointer to the bitstream of a video object
+ * @param pos file offset of the next read
+ */
+static void bs_reset(lv_video_bitstream_t * bs, uint32_t pos)
 {
-    lv_video_t * video = (lv_video_t *)obj;
-    SBufferInfo sDstBufInfo = {0};
-    int32_t copiedLen = 0;
-    int32_t sliceSize = 0;
-    uint8_t * dst[3];
-    int32_t num_of_frames_in_buffer = 0;
-    int32_t leftDataLen;
+    bs->pos = pos;
+    bs->start = 0;
+    bs->scan = 0;
+    bs->end = 0;
+    bs->eof = false;
+}
 
-    static int32_t decodeBufStart = 0;
-    static int32_t decodeBufEnd   = 0;
+/**
+ * Continue reading the file from the start of a NALU. The file is read again only
+ * if the position is not in the window, e.g. a short clip restarts straight from the window.
+ * @param video pointer to a video object
+ * @param pos file offset of a NALU
+ */
+static void bs_seek(lv_video_t * video, uint32_t pos)
+{
+    lv_video_bitstream_t * bs = &video->bs;
 
-    if(isStartOfFile) {
-        decodeBufStart         = 0;
-        decodeBufEnd           = 0;
+    if(pos >= bs->pos && pos <= bs->pos + bs->end) {
+        bs->start = pos - bs->pos;
+        bs->scan = bs->start;
+        return;
     }
-    leftDataLen = len;
 
-    while(leftDataLen > 0) {
-        copiedLen = MIN(leftDataLen, ((int32_t)sizeof(s_decodeBuf) - decodeBufEnd));
+    lv_video_reader_seek(&video->reader, pos);
+    bs_reset(bs, pos);
+}
 
-        /* Copy the input data to the end of decode buffer. */
-        memcpy(&s_decodeBuf[decodeBufEnd], data, copiedLen);
-        decodeBufEnd += copiedLen;
-        data += copiedLen;
-        leftDataLen -= copiedLen;
+/**
+ * Get the next NALU of the file. The NALU stays in the window and it's valid until the next call.
+ * @param video pointer to a video object
+ * @param nalu the NALU with its start code
+ * @param len length of the NALU
+ * @return LV_RES_OK: a NALU is returned; LV_RES_INV: end of the file or read error
+ */
+static lv_res_t bs_next_nalu(lv_video_t * video, const uint8_t ** nalu, uint32_t * len)
+{
+    lv_video_bitstream_t * bs = &video->bs;
 
-        while(decodeBufStart < decodeBufEnd) {
-            sliceSize = search_nalu(&s_decodeBuf[decodeBufStart], decodeBufEnd - decodeBufStart);
-            if(video->exist) {
-                return 0;
-            }
-            /* Could not find NALU. */
-            if(sliceSize < 0) {
-                /* This is the file end part, pass them all to H264 decoder. */
-                if(isEndOfFile && (0 == leftDataLen)) {
-                    sliceSize = decodeBufEnd - decodeBufStart;
-                }
-                else {
-                    /* After searching the full buffer, no slice found, then drop the data in buffer. */
-                    if((decodeBufStart == 0) && (decodeBufEnd == sizeof(s_decodeBuf))) {
-                        /* Drop the decode buffer, fill using left input data. */
-                        decodeBufEnd   = 0;
-                        decodeBufStart = 0;
-                    }
-
-                    /* Have processed all slice in the buffer. */
-                    break;
-                }
-            }
-            /* Slice size too small, skip it. */
-            else if(sliceSize < 4) {
-                decodeBufStart += sliceSize;
-                continue;
-            }
-            /* Found NALU, decode. */
-            if(OpenH264_Decode(&s_decodeBuf[decodeBufStart], sliceSize, dst, &sDstBufInfo) == 0) {
-                if(sDstBufInfo.iBufferStatus == 1) {
-#if LV_USE_GUIDER_SIMULATOR
-                    CPU_DisplayFrame(sDstBufInfo, dst, obj);
-#else
-                    PXP_DisplayFrame(
-                        sDstBufInfo.UsrData.sSystemBuffer.iWidth, sDstBufInfo.UsrData.sSystemBuffer.iHeight,
-                        sDstBufInfo.pDst[0], sDstBufInfo.pDst[1], sDstBufInfo.pDst[2],
-                        sDstBufInfo.UsrData.sSystemBuffer.iStride[0], sDstBufInfo.UsrData.sSystemBuffer.iStride[1], obj);
-#endif
-                }
+    while(1) {
+        /* Find the `01` of the next `00 00 01`. It's rare in the compressed data so memchr skips most bytes. */
+        uint32_t scan = LV_MAX(bs->scan, bs->start + 2);
+        while(scan < bs->end) {
+            const uint8_t * one = memchr(&bs->buf[scan], 1, bs->end - scan);
+            if(one == NULL) break;
+
+            uint32_t pos = one - bs->buf;
+            scan = pos + 1;
+            if(bs->buf[pos - 1] != 0 || bs->buf[pos - 2] != 0) continue;
+
+            /* The start code might be `00 00 00 01` too. */
+            uint32_t sc = pos - 2;
+            if(sc > bs->start && bs->buf[sc - 1] == 0) sc--;
+
+            uint32_t nalu_start = bs->start;
+            bs->start = sc;
+            bs->scan = scan;
+            /* Nothing before the first start code. */
+            if(sc == nalu_start) continue;
+
+            *nalu = &bs->buf[nalu_start];
+            *len = sc - nalu_start;
+            return LV_RES_OK;
+        }
+        bs->scan = bs->end;
+
+        /* The last NALU ends with the file. */
+        if(bs->eof) {
+            if(bs->start == bs->end) return LV_RES_INV;
+            *nalu = &bs->buf[bs->start];
+            *len = bs->end - bs->start;
+            bs->start = bs->end;
+            return LV_RES_OK;
+        }
 
-            }
-            else {
-                LV_LOG_ERROR("decode error\r\n");
-            }
+        /* Move the incomplete NALU to the beginning to read the rest of it behind. */
+        if(bs->size - bs->end < DEMO_FILE_BUF_SIZE && bs->start > 0) {
+            memmove(bs->buf, &bs->buf[bs->start], bs->end - bs->start);
+            bs->pos += bs->start;
+            bs->end -= bs->start;
+            bs->scan -= bs->start;
+            bs->start = 0;
+        }
 
-            decodeBufStart += sliceSize;
+        if(bs->end == bs->size) {
+            LV_LOG_WARN("NALU larger than %d bytes, dropped", DEMO_DECODE_BUF_SIZE);
+            bs->pos += bs->end;
+            bs->start = 0;
+            bs->scan = 0;
+            bs->end = 0;
         }
 
-        /* Move the left data in decode buffer to the start of decode buffer,
-         * left input data will be appended to the end.
-         */
-        memcpy(s_decodeBuf, &s_decodeBuf[decodeBufStart], decodeBufEnd - decodeBufStart);
-        decodeBufEnd -= decodeBufStart;
-        decodeBufStart = 0;
+        /* Read straight into the window. */
+        uint32_t btr = LV_MIN(bs->size - bs->end, DEMO_FILE_BUF_SIZE);
+        uint32_t br = 0;
+        if(lv_video_reader_read(&video->reader, &bs->buf[bs->end], btr, &br) != LV_FS_RES_OK) return LV_RES_INV;
+        bs->end += br;
+        bs->eof = br < btr;
     }
+}
 
-    if(isEndOfFile) {
-        OpenH264_GetOption(&num_of_frames_in_buffer);
-        for(int32_t i = 0; i < num_of_frames_in_buffer; i++) {
-            dst[0] = NULL;
-            dst[1] = NULL;
-            dst[2] = NULL;
+static void decode_nalu(lv_obj_t * obj, const uint8_t * nalu, uint32_t len)
+{
+    ISVCDecoder * dec = ((lv_video_t *)obj)->decoder;
+    SBufferInfo sDstBufInfo = {0};
+    uint8_t * dst[3];
 
-            OpenH264_FlashFrame(dst, &sDstBufInfo);
-            if(sDstBufInfo.iBufferStatus == 1) {
-#if LV_USE_GUIDER_SIMULATOR
-                CPU_DisplayFrame(sDstBufInfo, dst, obj);
-#else
-                PXP_DisplayFrame(
-                    sDstBufInfo.UsrData.sSystemBuffer.iWidth, sDstBufInfo.UsrData.sSystemBuffer.iHeight,
-                    sDstBufInfo.pDst[0], sDstBufInfo.pDst[1], sDstBufInfo.pDst[2],
-                    sDstBufInfo.UsrData.sSystemBuffer.iStride[0], sDstBufInfo.UsrData.sSystemBuffer.iStride[1], obj);
-#endif
-            }
+    /* Too small or a not referenced picture while decoding is late. */
+    if(len < 4 || nalu_skip(obj, nalu, len)) return;
+
+    if((*dec)->DecodeFrameNoDelay(dec, nalu, len, dst, &sDstBufInfo) == 0) {
+        if(sDstBufInfo.iBufferStatus == 1) {
+            frame_decoded(obj, &sDstBufInfo, dst);
         }
     }
+    else {
+        LV_LOG_ERROR("decode error\r\n");
+    }
+}
 
-    return 0;
+/**
+ * Get the frames the decoder still holds at the end of the file
+ */
+static void decode_flush(lv_obj_t * obj)
+{
+    ISVCDecoder * dec = ((lv_video_t *)obj)->decoder;
+    SBufferInfo sDstBufInfo = {0};
+    uint8_t * dst[3];
+    int32_t num_of_frames_in_buffer = 0;
+
+    (*dec)->GetOption(dec, DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, &num_of_frames_in_buffer);
+    for(int32_t i = 0; i < num_of_frames_in_buffer; i++) {
+        dst[0] = NULL;
+        dst[1] = NULL;
+        dst[2] = NULL;
+
+        (*dec)->FlushFrame(dec, dst, &sDstBufInfo);
+        if(sDstBufInfo.iBufferStatus == 1) {
+            frame_decoded(obj, &sDstBufInfo, dst);
+        }
+    }
 }
 
+/**
+ * Decode the opened file in a loop. It's the body of the decode thread and returns when the widget is deleted.
+ * @param fileName unused, the file is opened by `lv_video_play()`
+ * @param obj pointer to a video object
+ */
 void Read_HFile(const char * fileName, lv_obj_t * obj)
 {
+    LV_UNUSED(fileName);
     lv_video_t * video = (lv_video_t *)obj;
-    uint32_t bytesRead;
-    while(1) {
-        int error = lv_fs_open(&video->h264File, video->file_name, LV_FS_MODE_RD);
-        if(error != LV_FS_RES_OK) {
-            break;
+    const uint8_t * nalu;
+    uint32_t len;
+    uint32_t nalu_cnt = 0;
+
+    bs_reset(&video->bs, 0);
+    while(!video->exist) {
+        if(video->seek_pending) seek_apply(obj);
+
+        /* While paused only the frame of a new position is decoded. */
+        if(video->play_status != 1 && !(video->preview && video->queue_cnt == 0)) {
+            VIDEO_SLEEP_MS(5);
+            continue;
         }
-        video->fileStart = true;
-        while(1) {
-            if(video->play_status == 1) {
-                error = lv_fs_read(&video->h264File, video->blk.data, DEMO_FILE_BUF_SIZE, &bytesRead);
-                if(error != LV_FS_RES_OK) {
-                    break;
-                }
-                video->blk.len           = bytesRead;
-                video->blk.isEndOfFile   = (DEMO_FILE_BUF_SIZE > bytesRead);
-                video->blk.isStartOfFile = video->fileStart;
-                video->fileStart         = false;
-                Decoder_Data(video->blk.data, video->blk.len, video->blk.isStartOfFile, video->blk.isEndOfFile, obj);
-                if(video->blk.isEndOfFile) {
-                    break;
-                }
-                if(video->exist) {
-                    video->blk.data = NULL;
-                    lv_fs_close(&video->h264File);
-                    return;
-                }
-            }
-            else {
 
-#if LV_USE_GUIDER_SIMULATOR
-                lv_task_handler();
-                usleep(5 * 1000);
-#else
-                vTaskDelay(5);
-#endif
-                continue;
-            }
+        if(bs_next_nalu(video, &nalu, &len) == LV_RES_OK) {
+            lv_video_index_add_nalu(&video->index, nalu, len, video->bs.pos + (uint32_t)(nalu - video->bs.buf));
+            decode_nalu(obj, nalu, len);
+            nalu_cnt++;
+            continue;
         }
-        lv_fs_close(&video->h264File);
+
+        decode_flush(obj);
+        if(video->bs.eof) lv_video_index_end(&video->index, video->bs.pos + video->bs.end);
+
+        /* Don't spin on an empty or unreadable file. */
+        if(nalu_cnt == 0) VIDEO_SLEEP_MS(100);
+        nalu_cnt = 0;
+
+        /* Loop the clip. The timestamps continue so the clock doesn't jump back. */
+        bs_seek(video, 0);
     }
 }
 
-#if !LV_USE_GUIDER_SIMULATOR
-int Video_InitPXP()
+/**
+ * Index the file beyond the decoded part without decoding it
+ * @param obj pointer to a video object
+ * @param frame index until this picture
+ */
+static void index_scan(lv_obj_t * obj, uint32_t frame)
 {
-    /* Initialize variables. */
+    lv_video_t * video = (lv_video_t *)obj;
+    const uint8_t * nalu;
+    uint32_t len;
 
+    /* Indexing stopped without memory. */
+    if(video->index.end == UINT32_MAX) return;
 
-    memset(&s_pxpPsBufferConfig, 0, sizeof(s_pxpPsBufferConfig));
-    memset(&s_pxpOutputBufferConfig, 0, sizeof(s_pxpOutputBufferConfig));
-    memset(s_lcdBuffer[0], 0, video_width * video_height * buffer_byte_per_pixel);
-    memset(s_lcdBuffer[1], 0, video_width * video_height * buffer_byte_per_pixel);
-    s_pxpPsBufferConfig.pixelFormat = kPXP_PsPixelFormatYVU420;
-    s_pxpPsBufferConfig.swapByte    = false,
+    bs_seek(video, video->index.end);
+    while(!video->exist && !video->index.complete && video->index.frame_cnt <= frame) {
+        if(bs_next_nalu(video, &nalu, &len) != LV_RES_OK) {
+            if(video->bs.eof) lv_video_index_end(&video->index, video->bs.pos + video->bs.end);
+            break;
+        }
+        lv_video_index_add_nalu(&video->index, nalu, len, video->bs.pos + (uint32_t)(nalu - video->bs.buf));
 
-    s_pxpOutputBufferConfig.pixelFormat    = kPXP_OutputPixelFormatRGB565;
-    s_pxpOutputBufferConfig.interlacedMode = kPXP_OutputProgressive;
-    s_pxpOutputBufferConfig.buffer1Addr    = 0U,
-    s_pxpOutputBufferConfig.pitchBytes     = (video_width * buffer_byte_per_pixel);
+        /* Indexing stopped, e.g. a NALU didn't fit in the window. */
+        if(video->index.end != video->bs.pos + video->bs.start) break;
+    }
+}
 
-    /* Initialize hardware. */
+/**
+ * Restart the decoding from the IDR picture before the requested position.
+ * The queued frames are dropped and the clock is set to the position.
+ * @param obj pointer to a video object
+ */
+static void seek_apply(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    VIDEO_LOCK();
+    uint32_t frame = (uint32_t)((uint64_t)video->seek_ms * video->fps / 1000);
+    video->seek_pending = false;
+    VIDEO_UNLOCK();
+
+    if(!video->index.complete && frame >= video->index.frame_cnt) index_scan(obj, frame);
+    if(video->index.complete && frame >= video->index.frame_cnt && video->index.frame_cnt > 0) {
+        frame = video->index.frame_cnt - 1;
+    }
+
+    /* Without an IDR picture before it, e.g. in a broken file, from the beginning. */
+    const lv_video_index_entry_t * idr = lv_video_index_find(&video->index, frame);
+
+#if VIDEO_PXP_ASYNC
+    /* The frame being converted would be queued after the seek. */
+    pxp_frame_wait(video);
+#endif
+
+    VIDEO_LOCK();
+    while(video->queue_cnt > 0) {
+        video->frames[video->queue[video->queue_rd]].state = LV_VIDEO_FRAME_FREE;
+        video->queue_rd = (video->queue_rd + 1) % LV_VIDEO_FRAME_CNT;
+        video->queue_cnt--;
+    }
+    video->frame_idx = idr ? idr->frame : 0;
+    video->seek_pts = (uint32_t)((uint64_t)frame * 1000 / video->fps);
+    video->clock_pts = video->seek_pts;
+    video->clock_running = false;
+    video->preview = video->play_status != 1;
+    VIDEO_UNLOCK();
+
+    video->skip_picture = false;
+    bs_seek(video, idr ? idr->pos : 0);
+}
+
+#if !LV_USE_GUIDER_SIMULATOR
+int Video_InitPXP()
+{
+#if VIDEO_PXP_ASYNC
+    /* The PXP is initialized by `lv_init()`, initializing it again would reset the running job. */
+    return 0;
+#else
+    /* Initialize hardware. The surfaces are configured for each frame as the videos share the PXP. */
     PXP_Init(PXP);
 
     PXP_SetProcessSurfaceBackGroundColor(PXP, 0U);
@@ -341,165 +549,240 @@ int Video_InitPXP()
     PXP_EnableCsc1(PXP, true);
 
     return 0;
+#endif
 }
 
-static void PXP_DisplayFrame(uint16_t width,
+static void PXP_DisplayFrame(lv_video_t * video,
+                             int32_t idx,
+                             uint16_t width,
                              uint16_t height,
                              const uint8_t * Y,
                              const uint8_t * U,
                              const uint8_t * V,
                              uint32_t Y_Stride,
                              uint32_t UV_Stride,
-                             lv_obj_t * obj)
+                             uint8_t * out)
 {
-    lv_video_t * video = (lv_video_t *)obj;
-    void * lcdFrameAddr;
-    bool rotate                    = false;
-    static uint16_t oldInputWidth  = 0U;
-    static uint16_t oldInputHeight = 0U;
+    pxp_ps_buffer_config_t psBufferConfig = {0};
+    pxp_output_buffer_config_t outputBufferConfig = {0};
+    bool rotate = (height > width);
 
-    uint16_t lcdWidth  = video_width;
-    uint16_t lcdHeight = video_height;
+    uint16_t lcdWidth  = video->video_w;
+    uint16_t lcdHeight = video->video_h;
 
-    DCACHE_CleanInvalidateByRange((uint32_t)Y, height * Y_Stride);
-    DCACHE_CleanInvalidateByRange((uint32_t)U, height * UV_Stride / 2);
-    DCACHE_CleanInvalidateByRange((uint32_t)V, height * UV_Stride / 2);
+    /* The PXP reads the planes from the memory. They are only cleaned, the decoder reads them again as references. */
+    DCACHE_CleanByRange((uint32_t)Y, height * Y_Stride);
+    DCACHE_CleanByRange((uint32_t)U, height * UV_Stride / 2);
+    DCACHE_CleanByRange((uint32_t)V, height * UV_Stride / 2);
 
     /* PS configure. */
-    s_pxpPsBufferConfig.bufferAddr  = (uint32_t)Y;
-    s_pxpPsBufferConfig.bufferAddrU = (uint32_t)U;
-    s_pxpPsBufferConfig.bufferAddrV = (uint32_t)V;
-    s_pxpPsBufferConfig.pitchBytes  = Y_Stride;
+    psBufferConfig.pixelFormat = kPXP_PsPixelFormatYVU420;
+    psBufferConfig.swapByte    = false;
+    psBufferConfig.bufferAddr  = (uint32_t)Y;
+    psBufferConfig.bufferAddrU = (uint32_t)U;
+    psBufferConfig.bufferAddrV = (uint32_t)V;
+    psBufferConfig.pitchBytes  = Y_Stride;
+
+    /* Output configure. */
+#if LV_COLOR_DEPTH == 32
+    outputBufferConfig.pixelFormat    = kPXP_OutputPixelFormatARGB8888;
+#else
+    outputBufferConfig.pixelFormat    = kPXP_OutputPixelFormatRGB565;
+#endif
+    outputBufferConfig.interlacedMode = kPXP_OutputProgressive;
+    outputBufferConfig.buffer0Addr    = (uint32_t)out;
+    outputBufferConfig.buffer1Addr    = 0U;
+    outputBufferConfig.pitchBytes     = lcdWidth * buffer_byte_per_pixel;
+    outputBufferConfig.width          = rotate ? lcdHeight : lcdWidth;
+    outputBufferConfig.height         = rotate ? lcdWidth : lcdHeight;
+
+#if VIDEO_PXP_ASYNC
+    /* Wait for the running job of LVGL or another video and start from the reset state like LVGL does. */
+    lv_gpu_nxp_pxp_lock();
+    PXP_ResetControl(PXP);
+    PXP_SetProcessSurfaceBackGroundColor(PXP, 0U);
+    PXP_SetAlphaSurfacePosition(PXP, 0xFFFFU, 0xFFFFU, 0U, 0U);
+#else
+    xSemaphoreTake(s_pxpMutex, portMAX_DELAY);
+#endif
 
-    PXP_SetProcessSurfaceBufferConfig(PXP, &s_pxpPsBufferConfig);
+    PXP_SetProcessSurfaceBufferConfig(PXP, &psBufferConfig);
 
-    /* Input frame size changed. */
-    if((oldInputHeight != height) || (oldInputWidth != width)) {
+    /* Another video or the LVGL PXP draw unit might have changed the settings, set them for every frame. */
+    PXP_SetCsc1Mode(PXP, kPXP_Csc1YCbCr2RGB);
+    PXP_EnableCsc1(PXP, true);
+    if(rotate) {
+        PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate90, kPXP_FlipDisable);
+        PXP_SetProcessSurfaceScaler(PXP, width, height, lcdHeight, lcdWidth);
+        PXP_SetProcessSurfacePosition(PXP, 0, 0, lcdHeight - 1, lcdWidth - 1);
+    }
+    else {
+        PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, kPXP_FlipDisable);
+        PXP_SetProcessSurfaceScaler(PXP, width, height, lcdWidth, lcdHeight);
+        PXP_SetProcessSurfacePosition(PXP, 0, 0, lcdWidth - 1, lcdHeight - 1);
+    }
 
-        rotate = (height > width);
+    PXP_SetOutputBufferConfig(PXP, &outputBufferConfig);
 
-        if(rotate) {
-            s_pxpOutputBufferConfig.width  = lcdHeight;
-            s_pxpOutputBufferConfig.height = lcdWidth;
+#if VIDEO_PXP_ASYNC
+    /* The next frame is decoded while the PXP converts this one. The decoder writes it into another picture
+     * of its pool, so the planes stay valid until the next conversion waits for this one in `lv_gpu_nxp_pxp_lock()`. */
+    video->pxp_frame = idx;
+    video->pxp_task = xTaskGetCurrentTaskHandle();
+    lv_gpu_nxp_pxp_run_async(pxp_complete_cb, video);
+#else
+    LV_UNUSED(idx);
+    PXP_Start(PXP);
 
-            PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate90, kPXP_FlipDisable);
-            PXP_SetProcessSurfaceScaler(PXP, width, height, lcdHeight, lcdWidth);
-            PXP_SetProcessSurfacePosition(PXP, 0, 0, lcdHeight - 1, lcdWidth - 1);
-        }
-        else {
-            s_pxpOutputBufferConfig.width  = lcdWidth;
-            s_pxpOutputBufferConfig.height = lcdHeight;
+    while(0U == (kPXP_CompleteFlag & PXP_GetStatusFlags(PXP))) {
+    }
+    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
 
-            PXP_SetProcessSurfaceScaler(PXP, width, height, lcdWidth, lcdHeight);
-            PXP_SetProcessSurfacePosition(PXP, 0, 0, lcdWidth - 1, lcdHeight - 1);
-        }
+    xSemaphoreGive(s_pxpMutex);
+#endif
+}
 
-        oldInputHeight = height;
-        oldInputWidth  = width;
-    }
+#if VIDEO_PXP_ASYNC
+/**
+ * Queue the frame converted by the PXP. Called from the PXP interrupt.
+ * @param param pointer to a video object
+ */
+static void pxp_complete_cb(void * param)
+{
+    lv_video_t * video = param;
+    BaseType_t taskAwake = pdFALSE;
 
-    lcdFrameAddr                              = s_lcdBuffer[s_lcdActiveFbIdx ^ 1];
-    s_pxpOutputBufferConfig.buffer0Addr = (uint32_t)lcdFrameAddr;
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    frame_queue_add(video, video->pxp_frame);
+    video->pxp_frame = -1;
+    taskEXIT_CRITICAL_FROM_ISR(mask);
 
-    PXP_SetOutputBufferConfig(PXP, &s_pxpOutputBufferConfig);
-    PXP_Start(PXP);
+    vTaskNotifyGiveFromISR((TaskHandle_t)video->pxp_task, &taskAwake);
+    portYIELD_FROM_ISR(taskAwake);
+}
 
-    while(0U == (kPXP_CompleteFlag & PXP_GetStatusFlags(PXP))) {
+/**
+ * Wait until the last frame is converted. The interrupt uses the frames and the decoder's picture till then.
+ * @param video pointer to a video object
+ */
+static void pxp_frame_wait(lv_video_t * video)
+{
+    while(video->pxp_frame >= 0) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
-    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+}
+#endif
 
-    video->frameImage.data = lcdFrameAddr;
-    s_lcdActiveFbIdx ^= 1;
-    lv_img_set_src(obj, &video->frameImage);
+static void video_task(void * param)
+{
+    lv_video_t * video = param;
+    Read_HFile(video->file_name, param);
+#if VIDEO_PXP_ASYNC
+    pxp_frame_wait(video);
+#endif
+
+    video->thread_running = false;
+    vTaskDelete(NULL);
 }
 #else
-static void CPU_DisplayFrame(SBufferInfo sDstBufInfo, unsigned char ** dst, lv_obj_t * obj)
+#if LV_VIDEO_SDL_YUV
+/**
+ * Copy the decoded planes into a frame as I420 without padding. The SDL renderer converts and scales them.
+ */
+static void frame_copy_yuv(lv_video_t * video, int32_t idx, SBufferInfo * info, uint8_t ** dst)
 {
-    lv_video_t * video = (lv_video_t *)obj;
-    int width = 0;
-    int height = 0;
-    if(sDstBufInfo.iBufferStatus == 1) {
-        width = sDstBufInfo.UsrData.sSystemBuffer.iWidth;
-        height = sDstBufInfo.UsrData.sSystemBuffer.iHeight;
-        int YStride = sDstBufInfo.UsrData.sSystemBuffer.iStride[0];
-        int UVStride = sDstBufInfo.UsrData.sSystemBuffer.iStride[1];
-        unsigned char * pPtr = NULL;
-        if(mallocInit == 0) {
-            rgb = malloc(2 * width * height);
-            py = malloc(width * height);
-            pu = malloc(width * height / 4);
-            pv = malloc(width * height / 4);
-            mallocInit = 1;
-        }
-        pPtr = dst[0];
-        for(int i = 0; i < height; i++) {
-            memcpy(py + i * width, pPtr, width);
-            pPtr += YStride;
+    lv_video_frame_t * frame = &video->frames[idx];
+    int32_t w = info->UsrData.sSystemBuffer.iWidth;
+    int32_t h = info->UsrData.sSystemBuffer.iHeight;
+    int32_t uv_w = (w + 1) / 2;
+    int32_t uv_h = (h + 1) / 2;
+    uint32_t size = w * h + 2 * uv_w * uv_h;
+
+    /* The decode thread owns the frame while decoding, so it can be enlarged. */
+    if(frame->size < size) {
+        uint8_t * buf = realloc(frame->buf, size);
+        if(buf == NULL) {
+            frame->yuv_w = 0;
+            frame->yuv_h = 0;
+            return;
         }
+        frame->buf = buf;
+        frame->size = size;
+    }
 
-        height = height / 2;
-        width = width / 2;
-        pPtr = dst[1];
-        for(int i = 0; i < height; i++) {
-            memcpy(pu + i * width, pPtr, width);
-            pPtr += UVStride;
-        }
-        pPtr = dst[2];
-        for(int i = 0; i < height; i++) {
-            memcpy(pv + i * width, pPtr, width);
-            pPtr += UVStride;
-        }
-        yuv420pToRgb565(width * 2, height * 2, video_width, video_height, py, pu, pv, (uint16_t *)rgb);
-        // update the image data.
-        video->frameImage.data = rgb;
-        lv_img_set_src(obj, &video->frameImage);
-        lv_img_cache_invalidate_src(lv_img_get_src(obj));
-        lv_obj_invalidate(obj);
-        lv_task_handler();
-        usleep(30 * 1000);
-    }
-}
-
-static void yuv420pToRgb565(int oriWidth, int oriHeight, int width, int height, uint8_t * py, uint8_t * pu,
-                            uint8_t * pv, unsigned short * dst)
-{
-    int y, u, v, yy, vr, ug, vg, ub;
-    int r, g, b;
-    int oriLine, oriCol;
-
-    for(int i = 0; i < height; i++) {
-        oriLine = i * oriHeight / height;
-        for(int j = 0; j < width; j++) {
-            oriCol = j * oriWidth / width;
-            y = py[oriLine * oriWidth + oriCol];
-            yy = y << 8;
-            u = pu[(oriLine / 2) * (oriWidth / 2) + (oriCol / 2)] - 128;
-            ug = 88 * u;
-            ub = 454 * u;
-            v = pv[(oriLine / 2) * (oriWidth / 2) + (oriCol / 2)] - 128;
-            vg = 183 * v;
-            vr = 359 * v;
-
-            r = (yy + vr) >> 8;
-            g = (yy - ug - vg) >> 8;
-            b = (yy + ub) >> 8;
-            if(r < 0)
-                r = 0;
-            if(r > 255)
-                r = 255;
-            if(g < 0)
-                g = 0;
-            if(g > 255)
-                g = 255;
-            if(b < 0)
-                b = 0;
-            if(b > 255)
-                b = 255;
-            dst[i * width + j] = (((unsigned short)r >> 3) << 11) | (((unsigned short)g >> 2) << 5) | (((
-                                                                                                            unsigned short)b >> 3) << 0);
-        }
+    uint8_t * y = frame->buf;
+    uint8_t * u = y + w * h;
+    uint8_t * v = u + uv_w * uv_h;
+    int32_t row;
+    for(row = 0; row < h; row++) {
+        memcpy(y + row * w, dst[0] + row * info->UsrData.sSystemBuffer.iStride[0], w);
     }
+    for(row = 0; row < uv_h; row++) {
+        memcpy(u + row * uv_w, dst[1] + row * info->UsrData.sSystemBuffer.iStride[1], uv_w);
+        memcpy(v + row * uv_w, dst[2] + row * info->UsrData.sSystemBuffer.iStride[1], uv_w);
+    }
+
+    frame->yuv_w = w;
+    frame->yuv_h = h;
+}
+
+/**
+ * Draw the displayed frame into the content area with the SDL renderer
+ * @param obj pointer to a video object
+ * @param draw_ctx the draw context of the event
+ */
+static void draw_yuv(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* Only the timer changes the displayed frame and it runs in the LVGL thread too. */
+    if(video->frame_shown < 0) return;
+    lv_video_frame_t * frame = &video->frames[video->frame_shown];
+    if(frame->yuv_w == 0) return;
+
+    lv_area_t coords;
+    lv_area_t clip;
+    lv_obj_get_content_coords(obj, &coords);
+    if(!_lv_area_intersect(&clip, draw_ctx->clip_area, &coords)) return;
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    lv_obj_init_draw_img_dsc(obj, LV_PART_MAIN, &img_dsc);
+
+    const lv_area_t * clip_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip;
+    lv_draw_sdl_img_yuv(draw_ctx, &img_dsc, &coords, obj, frame->buf, frame->yuv_w, frame->yuv_h, video->frame_id);
+    draw_ctx->clip_area = clip_ori;
+}
+#else
+static void CPU_DisplayFrame(lv_video_t * video, SBufferInfo sDstBufInfo, unsigned char ** dst, uint8_t * out)
+{
+    if(sDstBufInfo.iBufferStatus != 1 || video->line_buf == NULL) return;
+
+    /* Read the planes of the decoder in place. */
+    lv_video_yuv_t yuv;
+    yuv.y = dst[0];
+    yuv.u = dst[1];
+    yuv.v = dst[2];
+    yuv.y_stride = sDstBufInfo.UsrData.sSystemBuffer.iStride[0];
+    yuv.uv_stride = sDstBufInfo.UsrData.sSystemBuffer.iStride[1];
+    yuv.w = sDstBufInfo.UsrData.sSystemBuffer.iWidth;
+    yuv.h = sDstBufInfo.UsrData.sSystemBuffer.iHeight;
+
+    lv_video_yuv_convert(&yuv, out, video->video_w, video->video_h,
+                         LV_COLOR_DEPTH == 32 ? LV_VIDEO_YUV_OUT_ARGB8888 : LV_VIDEO_YUV_OUT_RGB565, video->line_buf);
+}
+#endif
+
+static void * video_thread(void * param)
+{
+    lv_video_t * video = param;
+    Read_HFile(video->file_name, param);
+
+    video->thread_running = false;
+    return NULL;
 }
+
 #endif
 
 /*=====================
@@ -512,6 +795,12 @@ void lv_video_set_src(lv_obj_t * obj, const char * src)
 
     lv_video_t * video = (lv_video_t *)obj;
 
+    /* Without the bitstream buffer the video can't be played, keep it without a source. */
+    if(video->bs.buf == NULL) {
+        LV_LOG_WARN("no bitstream buffer, %s is not set", src);
+        return;
+    }
+
     video->file_name = src;
 }
 
@@ -546,6 +835,116 @@ const char * lv_video_get_src(lv_obj_t * obj)
     return video->file_name;
 }
 
+void lv_video_set_fps(lv_obj_t * obj, uint32_t fps)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+    if(fps == 0) fps = LV_VIDEO_DEF_FPS;
+
+    VIDEO_LOCK();
+    video->fps = fps;
+    VIDEO_UNLOCK();
+
+    if(video->timer) lv_timer_set_period(video->timer, LV_MAX(500 / fps, 1));
+}
+
+void lv_video_set_speed(lv_obj_t * obj, uint16_t speed)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* Continue from the current position with the new speed. */
+    VIDEO_LOCK();
+    clock_rebase(video);
+    video->speed = speed;
+    VIDEO_UNLOCK();
+}
+
+void lv_video_seek(lv_obj_t * obj, uint32_t ms)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* The decode thread restarts from the new position. */
+    VIDEO_LOCK();
+    video->seek_ms = ms;
+    video->seek_pending = true;
+    VIDEO_UNLOCK();
+}
+
+uint16_t lv_video_get_speed(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    return video->speed;
+}
+
+uint32_t lv_video_get_dropped_cnt(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    return video->dropped_cnt;
+}
+
+uint32_t lv_video_get_duration(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+
+    if(!video->index.complete) return 0;
+
+    return (uint32_t)((uint64_t)video->index.frame_cnt * 1000 / video->fps);
+}
+
+void lv_video_set_overlay_driver(const lv_video_overlay_t * drv)
+{
+#if LV_VIDEO_SDL_YUV
+    /* The layer couldn't scan out the YUV frames. */
+    LV_UNUSED(drv);
+    LV_LOG_WARN("the overlay is not supported with the SDL renderer");
+#else
+    s_overlay = drv;
+#endif
+}
+
+void lv_video_overlay_release(lv_obj_t * obj, const void * buf)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* No lock as it might run in an interrupt: a single store, and the timer and the decode thread
+     * don't change a frame which is shown but not the current one. */
+    int32_t i;
+    for(i = 0; i < LV_VIDEO_FRAME_CNT; i++) {
+        if(video->frames[i].buf == buf) {
+            if(i != video->frame_shown && video->frames[i].state == LV_VIDEO_FRAME_SHOWN) {
+                video->frames[i].state = LV_VIDEO_FRAME_FREE;
+            }
+            break;
+        }
+    }
+}
+
+lv_res_t lv_video_save_index(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_video_t * video = (lv_video_t *)obj;
+    char path[LV_FS_MAX_PATH_LENGTH];
+
+    /* Not changed by the decode thread any more once it's complete. */
+    if(!video->index.complete || video->file_name == NULL) return LV_RES_INV;
+
+    lv_snprintf(path, sizeof(path), "%s.idx", video->file_name);
+    return lv_video_index_save(&video->index, path);
+}
 
 /**********************
  *   STATIC FUNCTIONS
@@ -558,15 +957,58 @@ static void lv_video_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     video->play_status = 1;
     video->exist = false;
-    OpenH264_Init();
+    video->overlay_open = false;
+    video->overlay_visible = false;
+    video->decoder = NULL;
     video->frameImage.header.always_zero = 0;
     video->frameImage.header.cf = LV_IMG_CF_TRUE_COLOR;
-    video->frameImage.header.w = video_width;
-    video->frameImage.header.h = video_height;
-    video->frameImage.data_size = video_width * video_height * LV_COLOR_SIZE / 8;
-    video->blk.data = (uint8_t *)malloc(DEMO_FILE_BUF_SIZE + 4);
+    video->frameImage.header.w = video->video_w;
+    video->frameImage.header.h = video->video_h;
+    video->frameImage.data_size = video->video_w * video->video_h * sizeof(lv_color_t);
+    video->bs.buf = (uint8_t *)malloc(DEMO_DECODE_BUF_SIZE);
+    video->bs.size = video->bs.buf ? DEMO_DECODE_BUF_SIZE : 0;
+    if(video->bs.buf == NULL) LV_LOG_WARN("can't allocate the %d bytes bitstream buffer", DEMO_DECODE_BUF_SIZE);
+    bs_reset(&video->bs, 0);
     video->frameImage.data = NULL;
-    video->fileStart = true;
+
+    uint32_t i;
+    for(i = 0; i < LV_VIDEO_FRAME_CNT; i++) {
+        video->frames[i].buf = calloc(video->frameImage.data_size, 1);
+        video->frames[i].state = LV_VIDEO_FRAME_FREE;
+#if LV_VIDEO_SDL_YUV
+        video->frames[i].size = video->frames[i].buf ? video->frameImage.data_size : 0;
+        video->frames[i].yuv_w = 0;
+        video->frames[i].yuv_h = 0;
+#endif
+    }
+    video->queue_rd = 0;
+    video->queue_cnt = 0;
+    video->frame_shown = -1;
+#if LV_VIDEO_SDL_YUV
+    video->frame_id = 0;
+#endif
+    video->timer = NULL;
+    video->dropped_cnt = 0;
+    video->fps = LV_VIDEO_DEF_FPS;
+    video->speed = 256;
+    video->clock_running = false;
+    video->clock_tick = 0;
+    video->clock_pts = 0;
+    video->frame_idx = 0;
+    video->skip_picture = false;
+    lv_video_index_init(&video->index);
+    video->seek_pending = false;
+    video->seek_ms = 0;
+    video->seek_pts = 0;
+    video->preview = false;
+    video->thread = NULL;
+    video->thread_running = false;
+#if LV_USE_GUIDER_SIMULATOR
+    video->line_buf = malloc(LV_VIDEO_YUV_LINE_BUF_SIZE(video->video_w));
+#else
+    video->pxp_frame = -1;
+    video->pxp_task = NULL;
+#endif
     LV_TRACE_OBJ_CREATE("finished");
     lv_obj_update_layout(obj);
 }
@@ -576,27 +1018,483 @@ static void lv_video_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_video_t * video = (lv_video_t *)obj;
     video->exist = true;
-    if(video->blk.data) {
-        free(video->blk.data);
-        video->blk.data = NULL;
+
+    /* Stop decoding before freeing the buffers. */
+    if(video->thread) {
+        video_thread_join(obj);
+        lv_video_reader_close(&video->reader);
+        lv_fs_close(&video->h264File);
+        decoder_release(video->decoder);
+        video->decoder = NULL;
+    }
+    if(video->timer) {
+        lv_timer_del(video->timer);
+        video->timer = NULL;
+    }
+    if(video->overlay_open) overlay_close(obj);
+
+    if(video->bs.buf) {
+        free(video->bs.buf);
+        video->bs.buf = NULL;
+    }
+
+#if LV_USE_GUIDER_SIMULATOR
+    free(video->line_buf);
+    video->line_buf = NULL;
+#endif
+    lv_video_index_free(&video->index);
+    lv_img_cache_invalidate_src(lv_img_get_src(obj));
+
+    uint32_t i;
+    for(i = 0; i < LV_VIDEO_FRAME_CNT; i++) {
+        free(video->frames[i].buf);
+        video->frames[i].buf = NULL;
+    }
+}
+
+static void lv_video_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* The overlay layer is above the UI and shows the frames: nothing to draw and nothing below is seen. */
+    if(video->overlay_visible) {
+        if(code == LV_EVENT_DRAW_MAIN || code == LV_EVENT_DRAW_POST) return;
+        if(code == LV_EVENT_COVER_CHECK) {
+            lv_cover_check_info_t * info = lv_event_get_param(e);
+            if(!_lv_area_is_in(info->area, &video->overlay_area, 0)) info->res = LV_COVER_RES_NOT_COVER;
+            return;
+        }
+    }
+
+#if LV_VIDEO_SDL_YUV
+    /* The frames aren't RGB images: the base of the image draws the background and SDL the frame. */
+    if(code == LV_EVENT_DRAW_MAIN) {
+        if(lv_obj_event_base(&lv_img_class, e) != LV_RES_OK) return;
+        draw_yuv(obj, lv_event_get_draw_ctx(e));
+        return;
+    }
+#endif
+
+    lv_obj_event_base(MY_CLASS, e);
+}
+
+/**
+ * Show the last decoded frame whose presentation time has come.
+ * The earlier ones weren't shown in time and are dropped to keep the playback real-time.
+ */
+static void video_timer_cb(lv_timer_t * timer)
+{
+    lv_obj_t * obj = timer->user_data;
+    lv_video_t * video = (lv_video_t *)obj;
+    int32_t show = -1;
+
+    if(video->overlay_open) overlay_update(obj);
+
+    VIDEO_LOCK();
+    if(video->play_status != 1) {
+        /* Stop the clock at the current position. */
+        if(video->clock_running) {
+            video->clock_pts = clock_get(video);
+            video->clock_running = false;
+        }
+
+        /* Show the frame of the position seeked to while paused. */
+        if(video->preview && video->queue_cnt > 0 && !overlay_busy(video)) {
+            video->preview = false;
+            show = video->queue[video->queue_rd];
+            video->queue_rd = (video->queue_rd + 1) % LV_VIDEO_FRAME_CNT;
+            video->queue_cnt--;
+        }
+    }
+    else if(!overlay_busy(video)) {
+        /* Start the clock with the first frame so the startup latency of the decoder isn't counted as delay. */
+        if(!video->clock_running && video->queue_cnt > 0) {
+            uint32_t pts = video->frames[video->queue[video->queue_rd]].pts;
+            if(video->frame_shown < 0) video->clock_pts = pts;
+            video->clock_tick = lv_tick_get();
+            video->clock_running = true;
+        }
+
+        uint32_t pos = clock_get(video);
+        while(video->queue_cnt > 0 && video->frames[video->queue[video->queue_rd]].pts <= pos) {
+            if(show >= 0) {
+                video->frames[show].state = LV_VIDEO_FRAME_FREE;
+                video->dropped_cnt++;
+            }
+            show = video->queue[video->queue_rd];
+            video->queue_rd = (video->queue_rd + 1) % LV_VIDEO_FRAME_CNT;
+            video->queue_cnt--;
+        }
+    }
+    if(show >= 0) {
+        /* The overlay driver releases the previous frame when the layer switches to the new one. */
+        if(video->frame_shown >= 0 && !video->overlay_visible) {
+            video->frames[video->frame_shown].state = LV_VIDEO_FRAME_FREE;
+        }
+        video->frames[show].state = LV_VIDEO_FRAME_SHOWN;
+        video->frame_shown = show;
+    }
+    VIDEO_UNLOCK();
+
+    if(show < 0) return;
+
+    video->frameImage.data = video->frames[show].buf;
+#if LV_VIDEO_SDL_YUV
+    video->frame_id = ++s_frameId;
+#else
+    lv_img_cache_invalidate_src(&video->frameImage);
+#endif
+    if(lv_img_get_src(obj) != &video->frameImage) lv_img_set_src(obj, &video->frameImage);
+    else if(!video->overlay_visible) lv_obj_invalidate(obj);
+
+    if(video->overlay_visible) s_overlay->show_cb(obj, video->frames[show].buf);
+}
+
+/**
+ * Get where the overlay layer should show the frames
+ * @param obj pointer to a video object
+ * @param area store the area in display coordinates here
+ * @return true: the layer can show the frames; false: the widget is hidden or clipped, LVGL has to draw it
+ */
+static bool overlay_get_area(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    if(lv_obj_get_screen(obj) != lv_scr_act() || !lv_obj_is_visible(obj)) return false;
+
+    area->x1 = obj->coords.x1;
+    area->y1 = obj->coords.y1;
+    area->x2 = area->x1 + video->video_w - 1;
+    area->y2 = area->y1 + video->video_h - 1;
+
+    /* The layer can't be clipped by the parents. */
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(!_lv_area_is_in(area, &parent->coords, 0)) return false;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    return true;
+}
+
+/**
+ * Follow the widget with the overlay layer, or hand the frames back to LVGL while the layer can't show them
+ * @param obj pointer to a video object
+ */
+static void overlay_update(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+    lv_area_t area;
+
+    bool visible = overlay_get_area(obj, &area);
+    if(visible == video->overlay_visible && (!visible || _lv_area_is_equal(&area, &video->overlay_area))) return;
+
+    video->overlay_visible = visible;
+    if(visible) video->overlay_area = area;
+    s_overlay->move_cb(obj, visible ? &area : NULL);
+    if(visible && video->frame_shown >= 0) s_overlay->show_cb(obj, video->frames[video->frame_shown].buf);
+
+    /* Let LVGL draw the frame or uncover the area. */
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * Tell whether the overlay layer still reads the previous frame. It can't take a new one
+ * before the next frame starts. Call it with `VIDEO_LOCK()`.
+ * @param video pointer to a video object
+ * @return true: no frame can be shown now
+ */
+static bool overlay_busy(lv_video_t * video)
+{
+    if(!video->overlay_visible) return false;
+
+    int32_t i;
+    for(i = 0; i < LV_VIDEO_FRAME_CNT; i++) {
+        if(i != video->frame_shown && video->frames[i].state == LV_VIDEO_FRAME_SHOWN) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Give up the overlay layer. The frames it kept are released.
+ * @param obj pointer to a video object
+ */
+static void overlay_close(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    s_overlay->close_cb(obj);
+
+    VIDEO_LOCK();
+    video->overlay_open = false;
+    video->overlay_visible = false;
+    int32_t i;
+    for(i = 0; i < LV_VIDEO_FRAME_CNT; i++) {
+        if(i != video->frame_shown && video->frames[i].state == LV_VIDEO_FRAME_SHOWN) {
+            video->frames[i].state = LV_VIDEO_FRAME_FREE;
+        }
+    }
+    VIDEO_UNLOCK();
+}
+
+/**
+ * Get the position of the playback clock. Call it with `VIDEO_LOCK()`.
+ * @param video pointer to a video object
+ * @return the position in ms
+ */
+static uint32_t clock_get(lv_video_t * video)
+{
+    if(!video->clock_running) return video->clock_pts;
+
+    return video->clock_pts + (uint32_t)(((uint64_t)lv_tick_elaps(video->clock_tick) * video->speed) >> 8);
+}
+
+/**
+ * Continue the clock from its current position. Call it with `VIDEO_LOCK()`.
+ * @param video pointer to a video object
+ */
+static void clock_rebase(lv_video_t * video)
+{
+    video->clock_pts = clock_get(video);
+    video->clock_tick = lv_tick_get();
+}
+
+/**
+ * Tell whether a slice should be skipped. Pictures which are not referenced (`nal_ref_idc == 0`)
+ * are skipped while the decoder is more than a frame behind the playback clock or before the seek position.
+ * @param obj pointer to a video object
+ * @param nalu the NALU with its start code
+ * @param len length of the NALU
+ * @return true: don't decode the NALU
+ */
+static bool nalu_skip(lv_obj_t * obj, const uint8_t * nalu, int32_t len)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* Skip the start code. */
+    int32_t i = 0;
+    while(i < len - 2 && nalu[i] == 0) i++;
+    if(i >= len - 2 || nalu[i] != 1) return false;
+
+    uint8_t header = nalu[i + 1];
+    uint8_t type = header & 0x1F;
+    if(type != 1 && type != 5) return false;
+
+    /* A new picture starts if `first_mb_in_slice` is 0, i.e. its Exp-Golomb code is a single 1 bit. */
+    if(nalu[i + 2] & 0x80) {
+        video->skip_picture = false;
+        if((header & 0x60) == 0) {
+            VIDEO_LOCK();
+            uint32_t pts = (uint32_t)((uint64_t)video->frame_idx * 1000 / video->fps);
+            bool late = video->clock_running && pts + 1000 / video->fps < clock_get(video);
+            if(late || pts < video->seek_pts) {
+                video->skip_picture = true;
+                video->frame_idx++;
+                if(late) video->dropped_cnt++;
+            }
+            VIDEO_UNLOCK();
+        }
     }
 
+    return video->skip_picture;
+}
+
+static bool video_thread_create(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    video->thread_running = true;
 #if LV_USE_GUIDER_SIMULATOR
-    mallocInit = 0;
-    if(rgb) {
-        free(py);
-        free(pu);
-        free(pv);
-        free(rgb);
+    pthread_t * thread = malloc(sizeof(pthread_t));
+    if(thread == NULL || pthread_create(thread, NULL, video_thread, obj) != 0) {
+        free(thread);
+        video->thread_running = false;
+        return false;
     }
+    video->thread = thread;
 #else
-    if(s_lcdBuffer[0] != NULL && s_lcdBuffer[1] != NULL) {
-        free(s_lcdBuffer[0]);
-        free(s_lcdBuffer[1]);
-        s_lcdBuffer[0] = NULL;
-        s_lcdBuffer[1] = NULL;
+    TaskHandle_t task;
+    if(xTaskCreate(video_task, "video", LV_VIDEO_TASK_STACK_SIZE / sizeof(StackType_t), obj,
+                   LV_VIDEO_TASK_PRIORITY, &task) != pdPASS) {
+        video->thread_running = false;
+        return false;
     }
+    video->thread = task;
 #endif
-    lv_img_cache_invalidate_src(lv_img_get_src(obj));
+
+    return true;
+}
+
+/**
+ * Wait until the decode thread exits. `exist` has to be set before.
+ */
+static void video_thread_join(lv_obj_t * obj)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+#if LV_USE_GUIDER_SIMULATOR
+    pthread_join(*(pthread_t *)video->thread, NULL);
+    free(video->thread);
+#else
+    while(video->thread_running) {
+        VIDEO_SLEEP_MS(5);
+    }
+#endif
+    video->thread = NULL;
+}
+
+/**
+ * Get a free frame buffer to decode into and give it the presentation time of the next picture.
+ * Blocks while all the buffers are in use.
+ * @param obj pointer to a video object
+ * @param idx store the index of the frame here
+ * @return the buffer or NULL if the widget is being deleted or a seek drops the frame
+ */
+static uint8_t * frame_acquire(lv_obj_t * obj, int32_t * idx)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* The frames of a paused video are not consumed until a seek is applied. */
+    while(!video->exist && !video->seek_pending) {
+        VIDEO_LOCK();
+        int32_t i;
+        for(i = 0; i < LV_VIDEO_FRAME_CNT; i++) {
+            if(video->frames[i].state == LV_VIDEO_FRAME_FREE) {
+                video->frames[i].state = LV_VIDEO_FRAME_DECODING;
+                video->frames[i].pts = (uint32_t)((uint64_t)video->frame_idx * 1000 / video->fps);
+                video->frame_idx++;
+                break;
+            }
+        }
+        VIDEO_UNLOCK();
+
+        if(i < LV_VIDEO_FRAME_CNT) {
+            *idx = i;
+            return video->frames[i].buf;
+        }
+
+        /* The UI is behind, let it consume the queued frames. */
+        VIDEO_SLEEP_MS(2);
+    }
+
+    return NULL;
+}
+
+#if !VIDEO_PXP_ASYNC
+/**
+ * Put a decoded frame into the display queue
+ */
+static void frame_queue(lv_obj_t * obj, int32_t idx)
+{
+    VIDEO_LOCK();
+    frame_queue_add((lv_video_t *)obj, idx);
+    VIDEO_UNLOCK();
+}
+#endif
+
+/**
+ * Put a converted frame into the display queue. Call it with `VIDEO_LOCK()` or in a critical section of an interrupt.
+ * @param video pointer to a video object
+ * @param idx index of the frame
+ */
+static void frame_queue_add(lv_video_t * video, int32_t idx)
+{
+    video->frames[idx].state = LV_VIDEO_FRAME_QUEUED;
+    video->queue[(video->queue_rd + video->queue_cnt) % LV_VIDEO_FRAME_CNT] = idx;
+    video->queue_cnt++;
+}
+
+/**
+ * Convert a decoded frame into a free frame buffer and queue it for display
+ */
+static void frame_decoded(lv_obj_t * obj, SBufferInfo * info, uint8_t ** dst)
+{
+    lv_video_t * video = (lv_video_t *)obj;
+
+    /* Decoded only as a reference on the way to the seek position. */
+    VIDEO_LOCK();
+    bool before_seek = (uint32_t)((uint64_t)video->frame_idx * 1000 / video->fps) < video->seek_pts;
+    if(before_seek) video->frame_idx++;
+    VIDEO_UNLOCK();
+    if(before_seek) return;
+
+    int32_t idx;
+    uint8_t * out = frame_acquire(obj, &idx);
+    if(out == NULL) return;
+
+#if LV_VIDEO_SDL_YUV
+    LV_UNUSED(out);
+    frame_copy_yuv(video, idx, info, dst);
+#elif LV_USE_GUIDER_SIMULATOR
+    CPU_DisplayFrame(video, *info, dst, out);
+#else
+    LV_UNUSED(dst);
+    PXP_DisplayFrame(video, idx, info->UsrData.sSystemBuffer.iWidth, info->UsrData.sSystemBuffer.iHeight,
+                     info->pDst[0], info->pDst[1], info->pDst[2],
+                     info->UsrData.sSystemBuffer.iStride[0], info->UsrData.sSystemBuffer.iStride[1], out);
+#endif
+
+    /* Queued by `pxp_complete_cb()` when the PXP converted it asynchronously. */
+#if !VIDEO_PXP_ASYNC
+    frame_queue(obj, idx);
+#endif
+}
+
+/**
+ * Take a decoder from the pool and prepare it for a new stream
+ * @return the decoder or NULL if all of them are in use
+ */
+static ISVCDecoder * decoder_acquire(void)
+{
+    SDecodingParam sDecParam = {0};
+    int iLevelSetting = (int)WELS_LOG_WARNING;
+    uint32_t i;
+
+    for(i = 0; i < LV_VIDEO_DECODER_CNT; i++) {
+        if(!s_decoderPool[i].used) break;
+    }
+    if(i == LV_VIDEO_DECODER_CNT) return NULL;
+
+    video_decoder_t * slot = &s_decoderPool[i];
+    if(slot->dec == NULL) {
+        if(WelsCreateDecoder(&slot->dec) != 0) {
+            slot->dec = NULL;
+            return NULL;
+        }
+    }
+    else {
+        /* Drop the state of the previous stream. */
+        (*slot->dec)->Uninitialize(slot->dec);
+    }
+
+    sDecParam.uiTargetDqLayer             = 255;
+    sDecParam.eEcActiveIdc                = ERROR_CON_SLICE_COPY;
+    sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+    if((*slot->dec)->Initialize(slot->dec, &sDecParam) != 0) {
+        WelsDestroyDecoder(slot->dec);
+        slot->dec = NULL;
+        return NULL;
+    }
+    (*slot->dec)->SetOption(slot->dec, DECODER_OPTION_TRACE_LEVEL, &iLevelSetting);
+
+    slot->used = true;
+    return slot->dec;
+}
+
+/**
+ * Give back a decoder to the pool
+ * @param dec the decoder from `decoder_acquire()`
+ */
+static void decoder_release(ISVCDecoder * dec)
+{
+    uint32_t i;
+    for(i = 0; i < LV_VIDEO_DECODER_CNT; i++) {
+        if(s_decoderPool[i].dec == dec) s_decoderPool[i].used = false;
+    }
 }
 #endif
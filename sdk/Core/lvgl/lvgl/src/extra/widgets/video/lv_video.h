@@ -20,20 +20,69 @@ extern "C" {
 
 #if LV_USE_VIDEO != 0
 
+#include "lv_video_index.h"
+#include "lv_video_reader.h"
+
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_GUIDER_SIMULATOR && LV_USE_GPU_SDL
+    /* The frames stay YUV and the SDL renderer converts and scales them. */
+    #define LV_VIDEO_SDL_YUV 1
+#else
+    #define LV_VIDEO_SDL_YUV 0
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** State of a frame buffer*/
+enum {
+    LV_VIDEO_FRAME_FREE,        /**< Can be decoded into*/
+    LV_VIDEO_FRAME_DECODING,    /**< The decode thread writes it*/
+    LV_VIDEO_FRAME_QUEUED,      /**< Decoded, waits for display*/
+    LV_VIDEO_FRAME_SHOWN,       /**< The image source of the widget*/
+};
+typedef uint8_t lv_video_frame_state_t;
+
+typedef struct {
+    uint8_t * buf;                  /* `lv_color_t` pixels of the widget's size or an I420 picture with `LV_VIDEO_SDL_YUV`. */
+    uint32_t pts;                   /* Presentation time in ms from the start of the playback. */
+    lv_video_frame_state_t state;
+#if LV_VIDEO_SDL_YUV
+    uint32_t size;                  /* Allocated bytes of `buf`, enlarged for larger pictures. */
+    int16_t yuv_w;                  /* Size of the picture in `buf`, 0 if it couldn't be stored. */
+    int16_t yuv_h;
+#endif
+} lv_video_frame_t;
+
+/* Window of the H.264 file. The file is read straight into it and the NALUs are decoded in place. */
+typedef struct {
+    uint8_t * buf;
+    uint32_t size;
+    uint32_t pos;       /* File offset of `buf[0]`. */
+    uint32_t start;     /* Start of the next NALU. */
+    uint32_t scan;      /* The search for the next start code continues here. */
+    uint32_t end;       /* End of the data read from the file. */
+    bool eof;           /* The file is read until its end. */
+} lv_video_bitstream_t;
+
+/**
+ * Driver of a display controller layer which scans out the frames of a video directly.
+ * LVGL then doesn't draw the widget while the layer shows it.
+ */
 typedef struct {
-    uint8_t * data;     /* Pointer to data. */
-    uint32_t len;        /* Length of the data. */
-    bool isEndOfFile;   /* Has reached file end. */
-    bool isStartOfFile; /* Is start of file. */
-} file_data_block_t;
+    /* Reserve the layer for `obj` whose frames are `w` x `h` pixels. Return false if it's taken. */
+    bool (*open_cb)(lv_obj_t * obj, lv_coord_t w, lv_coord_t h);
+    /* Place the layer at `area` in display coordinates, or hide it if `area` is NULL. */
+    void (*move_cb)(lv_obj_t * obj, const lv_area_t * area);
+    /* Scan out `buf` from the next frame, showing the layer if it was hidden.
+     * Pass the previous buffer to `lv_video_overlay_release()` once it's not read any more. */
+    void (*show_cb)(lv_obj_t * obj, const void * buf);
+    /* Hide the layer and give it up. */
+    void (*close_cb)(lv_obj_t * obj);
+} lv_video_overlay_t;
 
 typedef struct {
     lv_obj_t obj;
@@ -52,9 +101,48 @@ typedef struct {
     const char * file_name;
     lv_img_dsc_t frameImage;
     lv_fs_file_t h264File;
-    file_data_block_t blk;
-    bool  fileStart;
-    bool exist;
+    lv_video_reader_t reader;           /* Reads `h264File` ahead while playing. */
+    lv_video_bitstream_t bs;
+    int16_t video_w;                    /* Size of the converted frames. */
+    int16_t video_h;
+    void * decoder;                     /* `ISVCDecoder *` taken from the decoder pool while playing. */
+#if LV_USE_GUIDER_SIMULATOR
+    uint8_t * line_buf;                 /* Scratch of the YUV converter. */
+#else
+    volatile int8_t pxp_frame;          /* Index of the frame converted by the PXP or -1. */
+    void * pxp_task;                    /* `TaskHandle_t` of the decode task, notified when the frame is converted. */
+#endif
+    volatile bool exist;
+    bool overlay_open;                  /* The layer of the overlay driver is reserved for the widget. */
+    bool overlay_visible;               /* The layer shows the frames at `overlay_area` instead of LVGL. */
+    lv_area_t overlay_area;
+    /* The decode thread fills the frames, the timer shows them. */
+    lv_video_frame_t frames[LV_VIDEO_FRAME_CNT];
+    uint8_t queue[LV_VIDEO_FRAME_CNT];  /* Indexes of the decoded frames in display order. */
+    uint8_t queue_rd;
+    uint8_t queue_cnt;
+    int8_t frame_shown;                 /* Index of the displayed frame or -1. */
+#if LV_VIDEO_SDL_YUV
+    uint32_t frame_id;                  /* Changes with the displayed frame, the renderer uploads it then. */
+#endif
+    lv_timer_t * timer;
+    uint32_t dropped_cnt;
+    /* Playback clock: the position is `clock_pts` at `clock_tick` and advances with `speed`. */
+    uint32_t fps;
+    uint16_t speed;                     /* 256: real-time, 512: double speed, 128: half speed. */
+    bool clock_running;
+    uint32_t clock_tick;
+    uint32_t clock_pts;
+    uint32_t frame_idx;                 /* Index of the next picture in the stream, gives its PTS. */
+    bool skip_picture;                  /* The slices of the current picture are not decoded. */
+    /* Seeking: the decoding restarts from the IDR picture before the position. */
+    lv_video_index_t index;
+    volatile bool seek_pending;
+    uint32_t seek_ms;
+    uint32_t seek_pts;                  /* The pictures before it are decoded only as references. */
+    bool preview;                       /* Show a frame of the new position while paused. */
+    void * thread;
+    volatile bool thread_running;
 } lv_video_t;
 
 extern const lv_obj_class_t lv_video_class;
@@ -62,6 +150,11 @@ extern const lv_obj_class_t lv_video_class;
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
+/**
+ * Start playing the source file. The frames are decoded in a separate thread and shown by an LVGL timer.
+ * It can be called repeatedly, only the first call opens the file.
+ * @param obj pointer to a video object
+ */
 void lv_video_play(lv_obj_t * obj);
 
 void Read_HFile(const char * fileName, lv_obj_t * obj);
@@ -82,6 +175,14 @@ lv_obj_t * lv_video_create(lv_obj_t * parent, int widgetWidth, int widgetHeight)
  * Setter functions
  *====================*/
 
+/**
+ * Set the driver of the display layer used to show the videos. The first video started after it
+ * gets the layer, the others are drawn by LVGL. The layer can't be clipped or rotated,
+ * it's hidden and LVGL draws the frames while the widget is not fully visible.
+ * @param drv pointer to a driver, only its pointer is saved. NULL to draw the videos by LVGL.
+ */
+void lv_video_set_overlay_driver(const lv_video_overlay_t * drv);
+
 /**
  * Set images for a state of the image button
  * @param obj pointer to an image button object
@@ -90,17 +191,74 @@ lv_obj_t * lv_video_create(lv_obj_t * parent, int widgetWidth, int widgetHeight)
 void lv_video_set_src(lv_obj_t * obj, const char * src);
 
 void lv_video_set_status(lv_obj_t * obj, int status);
+
+/**
+ * Set the frame rate of the clip. The raw H.264 stream has no time stamps, the frames are timed with it.
+ * @param obj pointer to a video object
+ * @param fps frames per second, `LV_VIDEO_DEF_FPS` by default
+ */
+void lv_video_set_fps(lv_obj_t * obj, uint32_t fps);
+
+/**
+ * Set the playback speed
+ * @param obj pointer to a video object
+ * @param speed 256: real-time, 512: double speed, 128: half speed
+ */
+void lv_video_set_speed(lv_obj_t * obj, uint16_t speed);
+
+/**
+ * Continue the playback from a position. The decoding restarts from the IDR picture before it.
+ * While paused the frame of the position is shown, e.g. to get a thumbnail.
+ * The file is indexed while it's played, seeking beyond the indexed part scans the file up to the position.
+ * @param obj pointer to a playing or paused video object
+ * @param ms position from the beginning of the clip, the last frame is shown if it's longer
+ */
+void lv_video_seek(lv_obj_t * obj, uint32_t ms);
+
 /*=====================
  * Getter functions
  *====================*/
 
 int lv_video_get_status(lv_obj_t * obj);
 const char * lv_video_get_src(lv_obj_t * obj);
+uint16_t lv_video_get_speed(lv_obj_t * obj);
+
+/**
+ * Get the number of frames dropped to keep the playback real-time: the decoded frames
+ * the UI couldn't show in time and the non-reference pictures skipped while the decoder was late.
+ * @param obj pointer to a video object
+ * @return the number of dropped frames since the start of the playback
+ */
+uint32_t lv_video_get_dropped_cnt(lv_obj_t * obj);
+
+/**
+ * Get the length of the clip. It's known once the file is indexed: after it was played once
+ * or seeked to its end, or if the index was loaded from `<src>.idx` when the playback started.
+ * @param obj pointer to a video object
+ * @return the length in ms or 0 if it's not known yet
+ */
+uint32_t lv_video_get_duration(lv_obj_t * obj);
 
 /*=====================
  * Other functions
  *====================*/
 
+/**
+ * Tell that the overlay layer doesn't read a frame buffer any more so a new frame can be decoded into it.
+ * It can be called from an interrupt.
+ * @param obj pointer to a video object
+ * @param buf the buffer passed to `show_cb` before
+ */
+void lv_video_overlay_release(lv_obj_t * obj, const void * buf);
+
+/**
+ * Save the index of the file to `<src>.idx`, it's loaded by `lv_video_play()` the next time
+ * so seeking doesn't have to scan the file.
+ * @param obj pointer to a video object
+ * @return LV_RES_OK: saved; LV_RES_INV: the file is not indexed completely yet or can't be written
+ */
+lv_res_t lv_video_save_index(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
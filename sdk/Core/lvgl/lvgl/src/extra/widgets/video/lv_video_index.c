@@ -0,0 +1,195 @@
+/**
+ * @file lv_video_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_video_index.h"
+
+#if LV_USE_VIDEO != 0
+
+#include "../../../misc/lv_mem.h"
+#include "../../../misc/lv_log.h"
+#include <stdlib.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define INDEX_MAGIC     0x4956564CU     /*"LVVI"*/
+#define INDEX_VERSION   1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Header of a saved index, followed by the entries*/
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t file_size;
+    uint32_t frame_cnt;
+    uint32_t cnt;
+} index_file_header_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool entry_add(lv_video_index_t * index, uint32_t pos, uint32_t frame);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_video_index_init(lv_video_index_t * index)
+{
+    lv_memset_00(index, sizeof(lv_video_index_t));
+    index->au_pos = UINT32_MAX;
+}
+
+void lv_video_index_free(lv_video_index_t * index)
+{
+    /*The decode thread builds it, the LVGL heap is not thread safe*/
+    free(index->entries);
+    lv_video_index_init(index);
+}
+
+void lv_video_index_add_nalu(lv_video_index_t * index, const uint8_t * nalu, uint32_t len, uint32_t pos)
+{
+    if(index->complete || pos != index->end) return;
+    index->end = pos + len;
+
+    /*Skip the start code*/
+    uint32_t i = 0;
+    while(i + 2 < len && nalu[i] == 0) i++;
+    if(i + 2 >= len || nalu[i] != 1) return;
+
+    uint8_t type = nalu[i + 1] & 0x1F;
+
+    /*SEI, SPS, PPS and access unit delimiter: they belong to the next picture*/
+    if(type >= 6 && type <= 9) {
+        if(index->au_pos == UINT32_MAX) index->au_pos = pos;
+        return;
+    }
+    if(type != 1 && type != 5) return;
+
+    /*Only the first slice of a picture (`first_mb_in_slice == 0`) is counted*/
+    if(nalu[i + 2] & 0x80) {
+        if(type == 5) {
+            uint32_t au_pos = index->au_pos != UINT32_MAX ? index->au_pos : pos;
+            if(!entry_add(index, au_pos, index->frame_cnt)) {
+                /*Not indexed any further without memory*/
+                index->end = UINT32_MAX;
+            }
+        }
+        index->frame_cnt++;
+    }
+    index->au_pos = UINT32_MAX;
+}
+
+void lv_video_index_end(lv_video_index_t * index, uint32_t file_size)
+{
+    if(index->end == file_size) index->complete = true;
+}
+
+const lv_video_index_entry_t * lv_video_index_find(const lv_video_index_t * index, uint32_t frame)
+{
+    /*The last entry whose frame is not after `frame`*/
+    uint32_t lo = 0;
+    uint32_t hi = index->cnt;
+    while(lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if(index->entries[mid].frame <= frame) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo > 0 ? &index->entries[lo - 1] : NULL;
+}
+
+lv_res_t lv_video_index_load(lv_video_index_t * index, const char * path, uint32_t file_size)
+{
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+    index_file_header_t header;
+    uint32_t br = 0;
+    lv_res_t res = LV_RES_INV;
+    if(lv_fs_read(&f, &header, sizeof(header), &br) == LV_FS_RES_OK && br == sizeof(header) &&
+       header.magic == INDEX_MAGIC && header.version == INDEX_VERSION && header.file_size == file_size &&
+       header.cnt > 0) {
+        uint32_t size = header.cnt * sizeof(lv_video_index_entry_t);
+        index->entries = malloc(size);
+        if(index->entries && lv_fs_read(&f, index->entries, size, &br) == LV_FS_RES_OK && br == size) {
+            index->cnt = header.cnt;
+            index->size = header.cnt;
+            index->end = file_size;
+            index->frame_cnt = header.frame_cnt;
+            index->complete = true;
+            res = LV_RES_OK;
+        }
+        else {
+            lv_video_index_free(index);
+        }
+    }
+
+    lv_fs_close(&f);
+    if(res != LV_RES_OK) LV_LOG_WARN("invalid index file %s", path);
+    return res;
+}
+
+lv_res_t lv_video_index_save(const lv_video_index_t * index, const char * path)
+{
+    if(!index->complete) return LV_RES_INV;
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_WR) != LV_FS_RES_OK) return LV_RES_INV;
+
+    index_file_header_t header;
+    header.magic = INDEX_MAGIC;
+    header.version = INDEX_VERSION;
+    header.file_size = index->end;
+    header.frame_cnt = index->frame_cnt;
+    header.cnt = index->cnt;
+
+    uint32_t size = index->cnt * sizeof(lv_video_index_entry_t);
+    uint32_t bw = 0;
+    lv_res_t res = LV_RES_INV;
+    if(lv_fs_write(&f, &header, sizeof(header), &bw) == LV_FS_RES_OK && bw == sizeof(header) &&
+       lv_fs_write(&f, index->entries, size, &bw) == LV_FS_RES_OK && bw == size) {
+        res = LV_RES_OK;
+    }
+
+    lv_fs_close(&f);
+    return res;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool entry_add(lv_video_index_t * index, uint32_t pos, uint32_t frame)
+{
+    if(index->cnt == index->size) {
+        uint32_t size = index->size ? index->size * 2 : 16;
+        lv_video_index_entry_t * entries = realloc(index->entries, size * sizeof(lv_video_index_entry_t));
+        if(entries == NULL) return false;
+        index->entries = entries;
+        index->size = size;
+    }
+
+    index->entries[index->cnt].pos = pos;
+    index->entries[index->cnt].frame = frame;
+    index->cnt++;
+    return true;
+}
+
+#endif /*LV_USE_VIDEO*/
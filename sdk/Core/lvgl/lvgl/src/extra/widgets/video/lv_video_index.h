@@ -0,0 +1,118 @@
+/**
+ * @file lv_video_index.h
+ * Index of the IDR pictures of an H.264 file to seek and loop without decoding from the beginning.
+ */
+
+#ifndef LV_VIDEO_INDEX_H
+#define LV_VIDEO_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#include "../../../misc/lv_types.h"
+#include "../../../misc/lv_fs.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#if LV_USE_VIDEO != 0
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * A point where the decoding can start
+ */
+typedef struct {
+    uint32_t pos;       /**< File offset of the access unit of the IDR picture, with its SPS and PPS*/
+    uint32_t frame;     /**< Index of the IDR picture in the stream*/
+} lv_video_index_entry_t;
+
+typedef struct {
+    lv_video_index_entry_t * entries;   /**< In file order*/
+    uint32_t cnt;
+    uint32_t size;                      /**< Number of the allocated entries*/
+    uint32_t end;                       /**< The file is indexed up to this offset*/
+    uint32_t frame_cnt;                 /**< Number of the pictures before `end`*/
+    uint32_t au_pos;                    /**< Start of the NALUs before the next picture or `UINT32_MAX`*/
+    bool complete;                      /**< The whole file is indexed, `frame_cnt` is the length of the clip*/
+} lv_video_index_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty index
+ * @param index pointer to an index
+ */
+void lv_video_index_init(lv_video_index_t * index);
+
+/**
+ * Free the entries of an index and empty it
+ * @param index pointer to an index
+ */
+void lv_video_index_free(lv_video_index_t * index);
+
+/**
+ * Index a NALU of the file. The NALUs have to come in file order, the ones not continuing
+ * the indexed part are ignored, e.g. the ones decoded again after seeking back.
+ * @param index pointer to an index
+ * @param nalu the NALU with its start code
+ * @param len length of the NALU
+ * @param pos file offset of the NALU
+ */
+void lv_video_index_add_nalu(lv_video_index_t * index, const uint8_t * nalu, uint32_t len, uint32_t pos);
+
+/**
+ * Tell that the file was read until its end
+ * @param index pointer to an index
+ * @param file_size size of the file. The index is complete if it was indexed until it.
+ */
+void lv_video_index_end(lv_video_index_t * index, uint32_t file_size);
+
+/**
+ * Find the last IDR picture not after a picture
+ * @param index pointer to an index
+ * @param frame index of a picture
+ * @return the entry to start decoding from or NULL if there is none
+ */
+const lv_video_index_entry_t * lv_video_index_find(const lv_video_index_t * index, uint32_t frame);
+
+/**
+ * Load a complete index saved by `lv_video_index_save()`
+ * @param index pointer to an empty index
+ * @param path path of the index file
+ * @param file_size size of the H.264 file, a stale index of another size is refused
+ * @return LV_RES_OK: loaded; LV_RES_INV: missing or not matching file, `index` stays empty
+ */
+lv_res_t lv_video_index_load(lv_video_index_t * index, const char * path, uint32_t file_size);
+
+/**
+ * Save a complete index. The file is in native byte order.
+ * @param index pointer to a complete index
+ * @param path path of the index file
+ * @return LV_RES_OK: saved; LV_RES_INV: the index is not complete or the file can't be written
+ */
+lv_res_t lv_video_index_save(const lv_video_index_t * index, const char * path);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_VIDEO*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_VIDEO_INDEX_H*/
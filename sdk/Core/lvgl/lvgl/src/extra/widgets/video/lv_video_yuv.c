@@ -0,0 +1,231 @@
+/**
+ * @file lv_video_yuv.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_video_yuv.h"
+
+#if LV_USE_VIDEO != 0
+
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__ARM_FEATURE_MVE))
+    /*GCC/Clang vector extensions, mapped to SSE2/AVX2, NEON or Helium by the compiler*/
+    #define YUV_SIMD    1
+    #if defined(__AVX2__)
+        #define YUV_SIMD_PX_CNT 16
+    #else
+        #define YUV_SIMD_PX_CNT 8
+    #endif
+#else
+    #define YUV_SIMD    0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if YUV_SIMD
+/*One pixel per lane*/
+typedef uint8_t yuv_simd_u8_t __attribute__((vector_size(YUV_SIMD_PX_CNT)));
+typedef int16_t yuv_simd_i16_t __attribute__((vector_size(YUV_SIMD_PX_CNT * 2)));
+typedef uint16_t yuv_simd_u16_t __attribute__((vector_size(YUV_SIMD_PX_CNT * 2)));
+typedef uint32_t yuv_simd_u32_t __attribute__((vector_size(YUV_SIMD_PX_CNT * 4)));
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void scale_row(const uint8_t * y, const uint8_t * u, const uint8_t * v, int32_t src_w,
+                      uint8_t * y_line, uint8_t * u_line, uint8_t * v_line, int32_t dst_w);
+static void expand_chroma(const uint8_t * u, const uint8_t * v, uint8_t * u_line, uint8_t * v_line, int32_t w);
+static void convert_row(const uint8_t * y, const uint8_t * u, const uint8_t * v, void * dst, int32_t w,
+                        lv_video_yuv_out_t out);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_video_yuv_convert(const lv_video_yuv_t * src, void * dst, int32_t dst_w, int32_t dst_h,
+                          lv_video_yuv_out_t out, uint8_t * line_buf)
+{
+    uint8_t * y_line = line_buf;
+    uint8_t * u_line = line_buf + dst_w;
+    uint8_t * v_line = u_line + dst_w;
+    uint32_t row_size = dst_w * (out == LV_VIDEO_YUV_OUT_ARGB8888 ? 4 : 2);
+    uint8_t * dst_row = dst;
+
+    /*Source row of the destination row `i` is `i * src->h / dst_h`, stepped without division*/
+    int32_t sy = 0;
+    int32_t sy_prev = -1;
+    int32_t sy_acc = 0;
+    int32_t sy_step = src->h / dst_h;
+    int32_t sy_rem = src->h % dst_h;
+
+    int32_t i;
+    for(i = 0; i < dst_h; i++) {
+        if(sy == sy_prev) {
+            /*Enlarged: the same source row again*/
+            lv_memcpy(dst_row, dst_row - row_size, row_size);
+        }
+        else {
+            const uint8_t * y = src->y + sy * src->y_stride;
+            const uint8_t * u = src->u + (sy >> 1) * src->uv_stride;
+            const uint8_t * v = src->v + (sy >> 1) * src->uv_stride;
+
+            if(dst_w == src->w) {
+                expand_chroma(u, v, u_line, v_line, dst_w);
+                convert_row(y, u_line, v_line, dst_row, dst_w, out);
+            }
+            else {
+                scale_row(y, u, v, src->w, y_line, u_line, v_line, dst_w);
+                convert_row(y_line, u_line, v_line, dst_row, dst_w, out);
+            }
+            sy_prev = sy;
+        }
+
+        dst_row += row_size;
+        sy += sy_step;
+        sy_acc += sy_rem;
+        if(sy_acc >= dst_h) {
+            sy_acc -= dst_h;
+            sy++;
+        }
+    }
+
+    /*The alpha plane follows the color plane*/
+    if(out == LV_VIDEO_YUV_OUT_RGB565A8) lv_memset(dst_row, 0xFF, dst_w * dst_h);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Pick the source pixels of a destination row with one Y, U and V per destination pixel
+ */
+static void scale_row(const uint8_t * y, const uint8_t * u, const uint8_t * v, int32_t src_w,
+                      uint8_t * y_line, uint8_t * u_line, uint8_t * v_line, int32_t dst_w)
+{
+    /*Source column of the destination column `j` is `j * src_w / dst_w`*/
+    int32_t sx = 0;
+    int32_t sx_acc = 0;
+    int32_t sx_step = src_w / dst_w;
+    int32_t sx_rem = src_w % dst_w;
+
+    int32_t j;
+    for(j = 0; j < dst_w; j++) {
+        y_line[j] = y[sx];
+        u_line[j] = u[sx >> 1];
+        v_line[j] = v[sx >> 1];
+
+        sx += sx_step;
+        sx_acc += sx_rem;
+        if(sx_acc >= dst_w) {
+            sx_acc -= dst_w;
+            sx++;
+        }
+    }
+}
+
+/**
+ * Duplicate the chroma samples to have one per pixel
+ */
+static void expand_chroma(const uint8_t * u, const uint8_t * v, uint8_t * u_line, uint8_t * v_line, int32_t w)
+{
+    int32_t j;
+    for(j = 0; j < w - 1; j += 2) {
+        u_line[j] = u_line[j + 1] = u[j >> 1];
+        v_line[j] = v_line[j + 1] = v[j >> 1];
+    }
+    if(j < w) {
+        u_line[j] = u[j >> 1];
+        v_line[j] = v[j >> 1];
+    }
+}
+
+/**
+ * Convert a row with one Y, U and V per pixel.
+ * `((y << 8) + 359 * v) >> 8` and the like are split to fit in 16 bit lanes, e.g. to `y + v + ((103 * v) >> 8)`.
+ */
+static void convert_row(const uint8_t * y, const uint8_t * u, const uint8_t * v, void * dst, int32_t w,
+                        lv_video_yuv_out_t out)
+{
+    uint16_t * dst16 = dst;
+    uint32_t * dst32 = dst;
+    int32_t x = 0;
+
+#if YUV_SIMD
+    for(; x <= w - YUV_SIMD_PX_CNT; x += YUV_SIMD_PX_CNT) {
+        yuv_simd_u8_t y8;
+        yuv_simd_u8_t u8;
+        yuv_simd_u8_t v8;
+        __builtin_memcpy(&y8, y + x, sizeof(y8));
+        __builtin_memcpy(&u8, u + x, sizeof(u8));
+        __builtin_memcpy(&v8, v + x, sizeof(v8));
+
+        yuv_simd_i16_t yy = __builtin_convertvector(y8, yuv_simd_i16_t);
+        yuv_simd_i16_t uu = __builtin_convertvector(u8, yuv_simd_i16_t) - 128;
+        yuv_simd_i16_t vv = __builtin_convertvector(v8, yuv_simd_i16_t) - 128;
+
+        yuv_simd_i16_t r = yy + vv + ((vv * 103) >> 8);
+        yuv_simd_i16_t g = yy - vv + ((vv * 73 - uu * 88) >> 8);
+        yuv_simd_i16_t b = yy + uu * 2 + ((uu * -58) >> 8);
+
+        /*Clamp to 0..255 with masks: negative lanes are cleared, too large ones set to all ones*/
+        r = ((r & (r >= 0)) | (r > 255)) & 0xFF;
+        g = ((g & (g >= 0)) | (g > 255)) & 0xFF;
+        b = ((b & (b >= 0)) | (b > 255)) & 0xFF;
+
+        if(out == LV_VIDEO_YUV_OUT_ARGB8888) {
+            yuv_simd_u32_t px = __builtin_convertvector(b, yuv_simd_u32_t) |
+                                (__builtin_convertvector(g, yuv_simd_u32_t) << 8) |
+                                (__builtin_convertvector(r, yuv_simd_u32_t) << 16) | 0xFF000000;
+            __builtin_memcpy(dst32 + x, &px, sizeof(px));
+        }
+        else {
+            yuv_simd_u16_t px = (yuv_simd_u16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+#if LV_COLOR_16_SWAP
+            px = (px >> 8) | (px << 8);
+#endif
+            __builtin_memcpy(dst16 + x, &px, sizeof(px));
+        }
+    }
+#endif
+
+    /*The rest of the row or all of it without vector extensions. Branchless so the compiler can vectorize it.*/
+    for(; x < w; x++) {
+        int32_t yy = y[x];
+        int32_t uu = u[x] - 128;
+        int32_t vv = v[x] - 128;
+        int32_t r = LV_CLAMP(0, yy + vv + ((vv * 103) >> 8), 255);
+        int32_t g = LV_CLAMP(0, yy - vv + ((vv * 73 - uu * 88) >> 8), 255);
+        int32_t b = LV_CLAMP(0, yy + uu * 2 + ((uu * -58) >> 8), 255);
+
+        if(out == LV_VIDEO_YUV_OUT_ARGB8888) {
+            dst32[x] = (uint32_t)b | ((uint32_t)g << 8) | ((uint32_t)r << 16) | 0xFF000000;
+        }
+        else {
+            uint16_t px = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+#if LV_COLOR_16_SWAP
+            px = (uint16_t)((px >> 8) | (px << 8));
+#endif
+            dst16[x] = px;
+        }
+    }
+}
+
+#endif /*LV_USE_VIDEO*/
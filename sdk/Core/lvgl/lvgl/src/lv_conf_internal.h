@@ -379,6 +379,31 @@
     #endif
 #endif
 
+/*Number of the resolved style properties cached per object.
+ *The value of a property is looked up only once in the styles of the object and its parents
+ *and read from the cache until the styles or the state change.
+ *Costs about 12 bytes per entry for every drawn object. Must be a power of 2.
+ *0: to disable caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+        #define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+    #else
+        #define LV_OBJ_STYLE_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Maximal number of opaque objects collected on every rendered area to skip or clip the objects hidden by them.
+ *Objects fully covered by opaque objects above them are not drawn at all,
+ *the partially covered ones are drawn only on the bounding box of their visible parts.
+ *Costs a cover check of every object on the area. 0: to draw only from the topmost fully covering object*/
+#ifndef LV_REFR_OCCLUDER_CNT
+    #ifdef CONFIG_LV_REFR_OCCLUDER_CNT
+        #define LV_REFR_OCCLUDER_CNT CONFIG_LV_REFR_OCCLUDER_CNT
+    #else
+        #define LV_REFR_OCCLUDER_CNT 0
+    #endif
+#endif
+
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
  *LV_DITHER_GRADIENT implies allocating one or two more lines of the object's rendering surface
  *The increase in memory consumption is (32 bits * object width) plus 24 bits * object width if using error diffusion */
@@ -412,6 +437,49 @@
     #endif
 #endif
 
+/*Size of a D-cache line in bytes.
+ *The software rotation copies the pixels in tiles of a few cache lines.*/
+#ifndef LV_DRAW_SW_CACHE_LINE_SIZE
+    #ifdef CONFIG_LV_DRAW_SW_CACHE_LINE_SIZE
+        #define LV_DRAW_SW_CACHE_LINE_SIZE CONFIG_LV_DRAW_SW_CACHE_LINE_SIZE
+    #else
+        #define LV_DRAW_SW_CACHE_LINE_SIZE 32
+    #endif
+#endif
+
+/*1: Transpose the rotated tiles with GCC/Clang vector extensions.
+ *Worth it only if the compiler can map them to SIMD instructions (SSE, NEON, Helium)*/
+#ifndef LV_DRAW_SW_ROTATE_VECTOR
+    #ifdef CONFIG_LV_DRAW_SW_ROTATE_VECTOR
+        #define LV_DRAW_SW_ROTATE_VECTOR CONFIG_LV_DRAW_SW_ROTATE_VECTOR
+    #else
+        #define LV_DRAW_SW_ROTATE_VECTOR 0
+    #endif
+#endif
+
+/*1: Blend LV_COLOR_DEPTH 16 and 32 colors with SIMD kernels.
+ *GCC/Clang vector extensions are used with SSE2/AVX2, NEON or Helium,
+ *otherwise the channels are blended in parts of 32 bit registers, with the Cortex-M DSP instructions if available.
+ *With 16 bit colors only the blend modes are handled that way, the normal mixing is already done like that*/
+#ifndef LV_DRAW_SW_BLEND_SIMD
+    #ifdef CONFIG_LV_DRAW_SW_BLEND_SIMD
+        #define LV_DRAW_SW_BLEND_SIMD CONFIG_LV_DRAW_SW_BLEND_SIMD
+    #else
+        #define LV_DRAW_SW_BLEND_SIMD 0
+    #endif
+#endif
+
+/*1: Allow rendering the bands of the draw buffer in parallel with `lv_refr_set_parallel()`.
+ *The private render state of the draw units becomes thread-local.
+ *While the bands are rendered the gradient cache, the glyph cache of the fonts and the label hint are not used.*/
+#ifndef LV_USE_PARALLEL_REFR
+    #ifdef CONFIG_LV_USE_PARALLEL_REFR
+        #define LV_USE_PARALLEL_REFR CONFIG_LV_USE_PARALLEL_REFR
+    #else
+        #define LV_USE_PARALLEL_REFR 0
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -680,6 +748,17 @@
 
 #endif  /*LV_USE_LOG*/
 
+/*Storage class of the render state which is private to each thread of the parallel rendering*/
+#if LV_USE_PARALLEL_REFR
+    #if defined(_MSC_VER)
+        #define LV_THREAD_LOCAL __declspec(thread)
+    #else
+        #define LV_THREAD_LOCAL __thread
+    #endif
+#else
+    #define LV_THREAD_LOCAL
+#endif
+
 /*-------------
  * Asserts
  *-----------*/
@@ -787,6 +866,26 @@
     #endif
 #endif
 
+/*1: Record the time of the rendering phases, objects and draw calls in a ring buffer.
+ *It can be dumped as Chrome trace JSON with `lv_profiler_dump()`*/
+#ifndef LV_USE_PROFILER
+    #ifdef CONFIG_LV_USE_PROFILER
+        #define LV_USE_PROFILER CONFIG_LV_USE_PROFILER
+    #else
+        #define LV_USE_PROFILER 0
+    #endif
+#endif
+#if LV_USE_PROFILER
+    /*Number of events in the ring buffer*/
+    #ifndef LV_PROFILER_BUF_SIZE
+        #ifdef CONFIG_LV_PROFILER_BUF_SIZE
+            #define LV_PROFILER_BUF_SIZE CONFIG_LV_PROFILER_BUF_SIZE
+        #else
+            #define LV_PROFILER_BUF_SIZE 16384
+        #endif
+    #endif
+#endif
+
 /*1: Draw random colored rectangles over the redrawn areas*/
 #ifndef LV_USE_REFR_DEBUG
     #ifdef CONFIG_LV_USE_REFR_DEBUG
@@ -1531,6 +1630,48 @@
         #define LV_USE_VIDEO      1
     #endif
 #endif
+#if LV_USE_VIDEO
+    /*Number of frame buffers. The decoded frames wait in them for display, one is shown.*/
+    #ifndef LV_VIDEO_FRAME_CNT
+        #ifdef CONFIG_LV_VIDEO_FRAME_CNT
+            #define LV_VIDEO_FRAME_CNT CONFIG_LV_VIDEO_FRAME_CNT
+        #else
+            #define LV_VIDEO_FRAME_CNT 3
+        #endif
+    #endif
+    /*Frame rate of the clips*/
+    #ifndef LV_VIDEO_DEF_FPS
+        #ifdef CONFIG_LV_VIDEO_DEF_FPS
+            #define LV_VIDEO_DEF_FPS CONFIG_LV_VIDEO_DEF_FPS
+        #else
+            #define LV_VIDEO_DEF_FPS 30
+        #endif
+    #endif
+    /*Number of H.264 decoders shared by the video widgets. It limits the number of videos playing at once.*/
+    #ifndef LV_VIDEO_DECODER_CNT
+        #ifdef CONFIG_LV_VIDEO_DECODER_CNT
+            #define LV_VIDEO_DECODER_CNT CONFIG_LV_VIDEO_DECODER_CNT
+        #else
+            #define LV_VIDEO_DECODER_CNT 2
+        #endif
+    #endif
+    /*Number of the blocks of the H.264 file read ahead in the background while decoding. 0: read when needed.*/
+    #ifndef LV_VIDEO_READ_AHEAD_CNT
+        #ifdef CONFIG_LV_VIDEO_READ_AHEAD_CNT
+            #define LV_VIDEO_READ_AHEAD_CNT CONFIG_LV_VIDEO_READ_AHEAD_CNT
+        #else
+            #define LV_VIDEO_READ_AHEAD_CNT 2
+        #endif
+    #endif
+    /*Size of a block read ahead in bytes*/
+    #ifndef LV_VIDEO_READ_AHEAD_SIZE
+        #ifdef CONFIG_LV_VIDEO_READ_AHEAD_SIZE
+            #define LV_VIDEO_READ_AHEAD_SIZE CONFIG_LV_VIDEO_READ_AHEAD_SIZE
+        #else
+            #define LV_VIDEO_READ_AHEAD_SIZE (16 * 1024)
+        #endif
+    #endif
+#endif
 
 #ifndef LV_USE_LINE
     #ifdef _LV_KCONFIG_PRESENT
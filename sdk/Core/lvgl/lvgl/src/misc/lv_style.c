@@ -241,40 +241,39 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
     uint16_t * old_props = (uint16_t *)tmp;
-    uint32_t i;
-    for(i = 0; i < style->prop_cnt; i++) {
-        if(LV_STYLE_PROP_ID_MASK(old_props[i]) == prop) {
-            lv_style_value_t * old_values = (lv_style_value_t *)style->v_p.values_and_props;
-
-            if(style->prop_cnt == 2) {
-                style->prop_cnt = 1;
-                style->prop1 = i == 0 ? old_props[1] : old_props[0];
-                style->v_p.value1 = i == 0 ? old_values[1] : old_values[0];
-            }
-            else {
-                size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
-                uint8_t * new_values_and_props = lv_mem_alloc(size);
-                if(new_values_and_props == NULL) return false;
-                style->v_p.values_and_props = new_values_and_props;
-                style->prop_cnt--;
-
-                tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-                uint16_t * new_props = (uint16_t *)tmp;
-                lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
-
-                uint32_t j;
-                for(i = j = 0; j <= style->prop_cnt;
-                    j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
-                    if(old_props[j] != prop) {
-                        new_values[i] = old_values[j];
-                        new_props[i++] = old_props[j];
-                    }
+    uint32_t i = _lv_style_prop_lower_bound(old_props, style->prop_cnt, prop);
+    if(i < style->prop_cnt && LV_STYLE_PROP_ID_MASK(old_props[i]) == prop) {
+        lv_style_value_t * old_values = (lv_style_value_t *)style->v_p.values_and_props;
+
+        if(style->prop_cnt == 2) {
+            style->prop_cnt = 1;
+            style->prop1 = i == 0 ? old_props[1] : old_props[0];
+            style->v_p.value1 = i == 0 ? old_values[1] : old_values[0];
+        }
+        else {
+            size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
+            uint8_t * new_values_and_props = lv_mem_alloc(size);
+            if(new_values_and_props == NULL) return false;
+            style->v_p.values_and_props = new_values_and_props;
+            style->prop_cnt--;
+
+            tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+            uint16_t * new_props = (uint16_t *)tmp;
+            lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
+
+            /*Keep the order of the others to keep them sorted*/
+            uint32_t j;
+            for(i = j = 0; j <= style->prop_cnt;
+                j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
+                if(LV_STYLE_PROP_ID_MASK(old_props[j]) != prop) {
+                    new_values[i] = old_values[j];
+                    new_props[i++] = old_props[j];
                 }
             }
-
-            lv_mem_free(old_values);
-            return true;
         }
+
+        lv_mem_free(old_values);
+        return true;
     }
 
     return false;
@@ -427,13 +426,11 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
     if(style->prop_cnt > 1) {
         uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
-        int32_t i;
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(LV_STYLE_PROP_ID_MASK(props[i]) == prop_id) {
-                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                value_adjustment_helper(prop_and_meta, value, &props[i], &values[i]);
-                return;
-            }
+        uint32_t pos = _lv_style_prop_lower_bound(props, style->prop_cnt, prop_id);
+        if(pos < style->prop_cnt && LV_STYLE_PROP_ID_MASK(props[pos]) == prop_id) {
+            lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+            value_adjustment_helper(prop_and_meta, value, &props[pos], &values[pos]);
+            return;
         }
 
         size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
@@ -443,19 +440,29 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
 
         tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         props = (uint16_t *)tmp;
-        /*Shift all props to make place for the value before them*/
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
+        /*Shift all props to make place for the value before them, and the ones after `pos` by one more
+         *to insert the new property to its sorted place*/
+        int32_t i;
+        for(i = style->prop_cnt - 1; i >= (int32_t)pos; i--) {
+            props[i + 1 + sizeof(lv_style_value_t) / sizeof(uint16_t)] = props[i];
+        }
+        for(; i >= 0; i--) {
             props[i + sizeof(lv_style_value_t) / sizeof(uint16_t)] = props[i];
         }
+
+        /*Shift the values after `pos` into the freed place before the props*/
+        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+        for(i = style->prop_cnt - 1; i >= (int32_t)pos; i--) {
+            values[i + 1] = values[i];
+        }
         style->prop_cnt++;
 
         /*Go to the new position wit the props*/
         tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         props = (uint16_t *)tmp;
-        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
 
         /*Set the new property and value*/
-        value_adjustment_helper(prop_and_meta, value, &props[style->prop_cnt - 1], &values[style->prop_cnt - 1]);
+        value_adjustment_helper(prop_and_meta, value, &props[pos], &values[pos]);
     }
     else if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop_id) {
@@ -472,9 +479,10 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         uint8_t * tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
         lv_style_value_t * values = (lv_style_value_t *)values_and_props;
-        props[0] = style->prop1;
-        values[0] = value_tmp;
-        value_adjustment_helper(prop_and_meta, value, &props[1], &values[1]);
+        uint32_t pos = LV_STYLE_PROP_ID_MASK(style->prop1) < prop_id ? 1 : 0;
+        props[1 - pos] = style->prop1;
+        values[1 - pos] = value_tmp;
+        value_adjustment_helper(prop_and_meta, value, &props[pos], &values[pos]);
     }
     else {
         style->prop_cnt = 1;
@@ -11,6 +11,7 @@
 #include "../core/lv_obj.h"
 #include "../misc/lv_assert.h"
 #include "../core/lv_group.h"
+#include "../core/lv_refr.h"
 #include "../draw/lv_draw.h"
 #include "../misc/lv_color.h"
 #include "../misc/lv_math.h"
@@ -835,6 +836,9 @@ static void draw_main(lv_event_t * e)
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
 
+    /*The hint is written while drawing so it can't be shared by the threads of the parallel rendering*/
+    if(_lv_refr_is_parallel()) hint = NULL;
+
 #else
     /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
@@ -120,6 +120,7 @@ ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_log.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_math.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_mem.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_printf.c
+${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_profiler.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_style.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_style_gen.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/misc/lv_templ.c
@@ -202,6 +203,9 @@ ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/tabview/lv_tabview.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/textprogress/lv_textprogress.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/tileview/lv_tileview.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/video/lv_video.c
+${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/video/lv_video_yuv.c
+${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/video/lv_video_index.c
+${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/video/lv_video_reader.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/win/lv_win.c
 ${CMAKE_CURRENT_LIST_DIR}/lvgl/src/extra/widgets/menu/lv_menu.c
 )
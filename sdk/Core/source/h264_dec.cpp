@@ -14,49 +14,52 @@ extern "C" {
 
 #if LV_USE_VIDEO != 0
 
-static ISVCDecoder *s_pDecoder;
+/* Every video widget has its own decoder, the functions take it as the first parameter. */
 
-
-int OpenH264_Init(void)
+int OpenH264_Init(ISVCDecoder** ppDecoder)
 {
-    int result               = WelsCreateDecoder(&s_pDecoder);
+    int result               = WelsCreateDecoder(ppDecoder);
     SDecodingParam sDecParam = {0};
 
-    if (result == 0)
+    if (result != 0)
     {
-        sDecParam.uiTargetDqLayer             = 255;
-        sDecParam.eEcActiveIdc                = ERROR_CON_SLICE_COPY;
-        sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
-        result                                = s_pDecoder->Initialize(&sDecParam);
+        return -1;
     }
 
+    ISVCDecoder* pDecoder = *ppDecoder;
+
+    sDecParam.uiTargetDqLayer             = 255;
+    sDecParam.eEcActiveIdc                = ERROR_CON_SLICE_COPY;
+    sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+    result                                = pDecoder->Initialize(&sDecParam);
+
     int iLevelSetting = (int) WELS_LOG_WARNING;
-    s_pDecoder->SetOption (DECODER_OPTION_TRACE_LEVEL, &iLevelSetting);
+    pDecoder->SetOption (DECODER_OPTION_TRACE_LEVEL, &iLevelSetting);
     return (result == 0) ? 0 : -1;
 }
 
-int OpenH264_Decode(const unsigned char* pSrc, const int iSrcLen, unsigned char** ppDst, SBufferInfo* pDstInfo) {
+int OpenH264_Decode(ISVCDecoder* pDecoder, const unsigned char* pSrc, const int iSrcLen, unsigned char** ppDst, SBufferInfo* pDstInfo) {
     int rst;
-    rst = s_pDecoder->DecodeFrameNoDelay(pSrc, iSrcLen, ppDst, pDstInfo);
+    rst = pDecoder->DecodeFrameNoDelay(pSrc, iSrcLen, ppDst, pDstInfo);
     //DecodeFrame2
     return rst;
 }
 
-void OpenH264_GetOption(void* pOption)
+void OpenH264_GetOption(ISVCDecoder* pDecoder, void* pOption)
 {
-	s_pDecoder->GetOption(DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, pOption);
+	pDecoder->GetOption(DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, pOption);
 }
 
-void OpenH264_FlashFrame(unsigned char** ppDst, SBufferInfo* pDstInfo)
+void OpenH264_FlashFrame(ISVCDecoder* pDecoder, unsigned char** ppDst, SBufferInfo* pDstInfo)
 {
-	s_pDecoder->FlushFrame(ppDst, pDstInfo);
+	pDecoder->FlushFrame(ppDst, pDstInfo);
 }
 
 
-void OpenH264_Uninit(void)
+void OpenH264_Uninit(ISVCDecoder* pDecoder)
 {
-    s_pDecoder->Uninitialize();
-    WelsDestroyDecoder(s_pDecoder);
+    pDecoder->Uninitialize();
+    WelsDestroyDecoder(pDecoder);
 }
 
 #endif /* LV_USE_VIDEO */
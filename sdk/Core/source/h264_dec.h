@@ -22,11 +22,11 @@ extern "C" {
 #include <stdint.h>
 #include <stddef.h>
 
-int OpenH264_Init(void);
-int OpenH264_Decode(const unsigned char* pSrc, const int iSrcLen, unsigned char** ppDst, SBufferInfo* pDstInfo);
-void OpenH264_GetOption(void* pOption);
-void OpenH264_FlashFrame(unsigned char** ppDst, SBufferInfo* pDstInfo);
-void OpenH264_Uninit(void);
+int OpenH264_Init(ISVCDecoder** ppDecoder);
+int OpenH264_Decode(ISVCDecoder* pDecoder, const unsigned char* pSrc, const int iSrcLen, unsigned char** ppDst, SBufferInfo* pDstInfo);
+void OpenH264_GetOption(ISVCDecoder* pDecoder, void* pOption);
+void OpenH264_FlashFrame(ISVCDecoder* pDecoder, unsigned char** ppDst, SBufferInfo* pDstInfo);
+void OpenH264_Uninit(ISVCDecoder* pDecoder);
 
 #endif /* LV_USE_VIDEO */
 
@@ -74,6 +74,15 @@
 /*Default display refresh period in milliseconds. LVG will redraw changed areas with this period time*/
 #define LV_DISP_DEF_REFR_PERIOD 30
 
+/*Number of the invalid areas stored until the next refresh.
+ *If it runs out the new area is joined into the one growing the least by it*/
+#define LV_INV_BUF_SIZE 32
+
+/*Drawing an invalid area separately costs about as much as drawing this many pixels
+ *(finding the objects on it, flushing, etc.). Two areas are joined if their bounding box is cheaper.
+ *0: join only if the bounding box is not larger than them*/
+#define LV_INV_AREA_OVERHEAD 4096
+
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30
 
@@ -149,6 +158,19 @@
  *0 mean no caching.*/
 #define LV_GRAD_CACHE_DEF_SIZE 0
 
+/*Number of the resolved style properties cached per object.
+ *The value of a property is looked up only once in the styles of the object and its parents
+ *and read from the cache until the styles or the state change.
+ *Costs about 12 bytes per entry for every drawn object. Must be a power of 2.
+ *0: to disable caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 64
+
+/*Maximal number of opaque objects collected on every rendered area to skip or clip the objects hidden by them.
+ *Objects fully covered by opaque objects above them are not drawn at all,
+ *the partially covered ones are drawn only on the bounding box of their visible parts.
+ *Costs a cover check of every object on the area. 0: to draw only from the topmost fully covering object*/
+#define LV_REFR_OCCLUDER_CNT 16
+
 /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
  *LV_DITHER_GRADIENT implies allocating one or two more lines of the object's rendering surface
  *The increase in memory consumption is (32 bits * object width) plus 24 bits * object width if using error diffusion */
@@ -164,6 +186,25 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10U * 1024U)
 
+/*Size of a D-cache line in bytes.
+ *The software rotation copies the pixels in tiles of a few cache lines.*/
+#define LV_DRAW_SW_CACHE_LINE_SIZE 32
+
+/*1: Transpose the rotated tiles with GCC/Clang vector extensions.
+ *Worth it only if the compiler can map them to SIMD instructions (SSE, NEON, Helium)*/
+#define LV_DRAW_SW_ROTATE_VECTOR 0
+
+/*1: Blend LV_COLOR_DEPTH 16 and 32 colors with SIMD kernels.
+ *GCC/Clang vector extensions are used with SSE2/AVX2, NEON or Helium,
+ *otherwise the channels are blended in parts of 32 bit registers, with the Cortex-M DSP instructions if available.
+ *With 16 bit colors only the blend modes are handled that way, the normal mixing is already done like that*/
+#define LV_DRAW_SW_BLEND_SIMD 1
+
+/*1: Allow rendering the bands of the draw buffer in parallel with `lv_refr_set_parallel()`.
+ *The private render state of the draw units becomes thread-local.
+ *While the bands are rendered the gradient cache, the glyph cache of the fonts and the label hint are not used.*/
+#define LV_USE_PARALLEL_REFR 0
+
 /*-------------
  * GPU
  *-----------*/
@@ -261,6 +302,14 @@
 #define LV_USE_MEM_MONITOR_POS LV_ALIGN_BOTTOM_LEFT
 #endif    /* LV_USE_MEM_MONITOR */
 
+/*1: Record the time of the rendering phases, objects and draw calls in a ring buffer.
+ *It can be dumped as Chrome trace JSON with `lv_profiler_dump()`*/
+#define LV_USE_PROFILER 0
+#if LV_USE_PROFILER
+/*Number of events in the ring buffer*/
+#define LV_PROFILER_BUF_SIZE 16384
+#endif    /* LV_USE_PROFILER */
+
 /*1: Draw random colored rectangles over the redrawn areas*/
 #define LV_USE_REFR_DEBUG 0
 
@@ -552,6 +601,18 @@
 #define LV_USE_TILEVIEW 0
 
 #define LV_USE_VIDEO 0
+#if LV_USE_VIDEO
+/*Number of frame buffers. The decoded frames wait in them for display, one is shown.*/
+#define LV_VIDEO_FRAME_CNT 3
+/*Frame rate of the clips*/
+#define LV_VIDEO_DEF_FPS 30
+/*Number of H.264 decoders shared by the video widgets. It limits the number of videos playing at once.*/
+#define LV_VIDEO_DECODER_CNT 2
+/*Number of the blocks of the H.264 file read ahead in the background while decoding. 0: read when needed.*/
+#define LV_VIDEO_READ_AHEAD_CNT 2
+/*Size of a block read ahead in bytes*/
+#define LV_VIDEO_READ_AHEAD_SIZE (16 * 1024)
+#endif    /* LV_USE_VIDEO */
 
 #define LV_USE_WIN 0
 
@@ -164,6 +164,19 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10U * 1024U)
 
+/*Size of a D-cache line in bytes.
+ *The software rotation copies the pixels in tiles of a few cache lines.*/
+#define LV_DRAW_SW_CACHE_LINE_SIZE 32
+
+/*1: Transpose the rotated tiles with GCC/Clang vector extensions.
+ *Worth it only if the compiler can map them to SIMD instructions (SSE, NEON, Helium)*/
+#define LV_DRAW_SW_ROTATE_VECTOR 0
+
+/*1: Blend LV_COLOR_DEPTH 16 and 32 colors with SIMD kernels.
+ *GCC/Clang vector extensions are used with SSE2/AVX2, NEON or Helium,
+ *otherwise 32 bit colors are blended two channels at a time in 32 bit registers (Cortex-M DSP)*/
+#define LV_DRAW_SW_BLEND_SIMD 1
+
 /*-------------
  * GPU
  *-----------*/